@@ -0,0 +1,176 @@
+#include "utils/implicit.h"
+#include "utils/parser.h"
+#include "utils/plot.h"
+#include <chrono>
+#include <cstdio>
+
+// measures the math engine without any window
+// every result is printed as one CSV line: benchmark,case,items,ns_per_item
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const double minTime = 0.25;	// seconds that each measurement runs for at least
+const sizt solveSamples = 4096;
+const double viewLeft = -10.0;
+const double viewRight = 10.0;
+const double viewBottom = -5.625;
+const double viewTop = 5.625;
+const sizt viewColumns[] = {800, 1920, 3840};
+
+const char* const corpus[][2] = {
+	{"poly", "3x^5-2x^4+x^3/7-4x^2+x-12"},
+	{"trig", "sin(x)*cos(2x)+tan(x/3)-atan(x)"},
+	{"nested_pow", "((x^2+1)^1.5-(abs(x)+2)^0.5)^(1/3)"},
+	{"factorial", "abs(x)!/(abs(x)+1)!+(abs(round(x))+3)!"},
+	{"vars", "a*x^3+b*x^2+c*x+d+n*sin(f*x+g)-h*exp(-(x-k)^2/m)"},
+	{"mixed", "ln(abs(x)+1)*sqrt(x^2+1)+cbrt(x)*floor(x/2)-exp(-x^2)"}
+};
+
+const char* const curveCorpus[][2] = {
+	{"circle", "x^2+y^2=16"},
+	{"waves", "sin(x)=cos(y)"},
+	{"hyperbola", "x*y=1"},
+	{"dense", "sin(x*y)=0.3"}
+};
+
+const map<string, double> corpusVars = {
+	pair<string, double>("a", 0.5),
+	pair<string, double>("b", -1.5),
+	pair<string, double>("c", 2.0),
+	pair<string, double>("d", -3.0),
+	pair<string, double>("f", 3.0),
+	pair<string, double>("g", 0.1),
+	pair<string, double>("h", 4.0),
+	pair<string, double>("k", 1.0),
+	pair<string, double>("m", 2.5),
+	pair<string, double>("n", 1.25)
+};
+
+volatile double sink;	// keeps results from getting optimized away
+
+// runs func with a growing number of repetitions until it takes at least minTime and returns nanoseconds per repetition
+template <typename F>
+double measure(F func) {
+	for (sizt reps=1;; reps*=2) {
+		Clock::time_point start = Clock::now();
+		for (sizt i=0; i<reps; i++)
+			func();
+		double secs = std::chrono::duration<double>(Clock::now() - start).count();
+		if (secs >= minTime)
+			return secs * 1e9 / double(reps);
+	}
+}
+
+void print(const char* bench, const string& name, sizt items, double nsPerItem) {
+	printf("%s,%s,%zu,%.3f\n", bench, name.c_str(), items, nsPerItem);
+	fflush(stdout);
+}
+
+void benchParse(Parser& parser) {
+	Arena nodes;
+	for (const auto& it : corpus) {
+		string text = it[1];
+		double ns = measure([&]() {
+			nodes.reset();
+			sink = parser.createTree(text, nodes) ? 1.0 : 0.0;
+		});
+		print("parse", it[0], text.length(), ns / double(text.length()));
+	}
+}
+
+void benchSolve(Parser& parser) {
+	vector<double> xs(solveSamples), ys(solveSamples);
+	for (sizt i=0; i<xs.size(); i++)
+		xs[i] = viewLeft + (viewRight - viewLeft) * double(i) / double(xs.size());
+
+	for (const auto& it : corpus) {
+		Expression expr;
+		expr.set(parser, it[1]);
+		double ns = measure([&]() {
+			double sum = 0.0;
+			for (double x : xs)
+				sum += expr.solve(x, parser.getVars());
+			sink = sum;
+		});
+		print("solve", it[0], xs.size(), ns / double(xs.size()));
+
+		ns = measure([&]() {
+			expr.solveMany(xs.data(), ys.data(), xs.size(), parser.getVars());
+			sink = ys.back();
+		});
+		print("solve_many", it[0], xs.size(), ns / double(xs.size()));
+
+		ns = measure([&]() {
+			double sum = 0.0;
+			for (double x : xs)
+				sum += expr.solveDual(x, parser.getVars()).d2;
+			sink = sum;
+		});
+		print("solve_dual", it[0], xs.size(), ns / double(xs.size()));
+	}
+}
+
+// does what GraphView does when a view opens: samples all functions at once until the plot is finished
+void benchSample(Parser& parser) {
+	vector<Expression> exprs(sizeof(corpus) / sizeof(*corpus));
+	Bytecode code;
+	vector<uint> res;
+	for (sizt i=0; i<exprs.size(); i++) {
+		exprs[i].set(parser, corpus[i][1]);
+		res.push_back(code.append(exprs[i].getCode()));
+	}
+	code.optimize(res);
+
+	Sampler sampler;
+	for (sizt cols : viewColumns) {
+		double xscale = double(cols) / (viewRight - viewLeft);
+		double yscale = double(cols) * 9.0 / 16.0 / (viewTop - viewBottom);	// 16:9 window
+		sizt samples = 0;
+		double ns = measure([&]() {
+			Plot plot;
+			plot.getCode() = code;
+			plot.clear();
+			plot.setView(viewLeft, viewRight, viewBottom, viewTop, xscale, yscale);
+			while (!plot.update(sampler, parser.getVars(), Default::plotBudget));
+			samples = plot.getXs().size();
+		});
+		print("sample", ntos(cols) + "_columns", samples, ns / double(cols));
+	}
+}
+
+// does what GraphView does for a curve when the view changes: traces it through the whole view
+void benchImplicit(Parser& parser) {
+	Sampler sampler;
+	std::atomic<bool> cancel(false);
+	for (const auto& it : curveCorpus) {
+		Expression expr;
+		expr.set(parser, it[1]);
+		ImplicitPlot curve;
+		curve.getCode().optimize({curve.getCode().append(expr.getCode())});
+		curve.clear();
+		for (sizt cols : viewColumns) {
+			double scale = double(cols) / (viewRight - viewLeft);	// 16:9 window with square pixels
+			double ns = measure([&]() {
+				curve.update(sampler, viewLeft, viewRight, viewBottom, viewTop, scale, scale, parser.getVars(), cancel);
+				sink = double(curve.getLines(0).size());
+			});
+			print("implicit", string(it[0]) + '_' + ntos(cols) + "_columns", curve.getLines(0).size() / 2, ns / double(cols));
+		}
+	}
+}
+
+}
+
+int main() {
+	Parser parser;
+	parser.updateVars(corpusVars);
+
+	printf("benchmark,case,items,ns_per_item\n");
+	benchParse(parser);
+	benchSolve(parser);
+	benchSample(parser);
+	benchImplicit(parser);
+	return 0;
+}
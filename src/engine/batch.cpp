@@ -0,0 +1,173 @@
+#include "batch.h"
+#include "filer.h"
+#include <cmath>
+#include <cstdio>
+#include <future>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+Batch::Batch() :
+	start(0.0),
+	end(0.0),
+	step(0.0),
+	format(Format::csv)
+{}
+
+bool Batch::wanted(int argc, char** argv) {
+	return argc > 1 && string(argv[1]) == Default::argEval;
+}
+
+int Batch::run(int argc, char** argv) {
+	Batch batch;
+	if (!batch.readArgs(argc, argv)) {
+		printUsage();
+		return 1;
+	}
+
+	Parser parser;
+	Expression expr;
+	if (!batch.setExpression(expr, parser))
+		return 1;
+
+	FILE* file = stdout;
+	if (!batch.output.empty()) {
+		file = fopen(batch.output.c_str(), "wb");
+		if (!file) {
+			cerr << "couldn't open " << batch.output << endl;
+			return 1;
+		}
+	}
+#ifdef _WIN32
+	else if (batch.format == Format::binary)
+		_setmode(_fileno(stdout), _O_BINARY);
+#endif
+	int ret = batch.evaluate(expr, parser, file);
+	if (file != stdout)
+		fclose(file);
+	return ret;
+}
+
+bool Batch::readArgs(int argc, char** argv) {
+	vector<string> vals;
+	for (int i=2; i<argc; i++) {
+		string arg = argv[i];
+		if (arg == Default::argCsv)
+			format = Format::csv;
+		else if (arg == Default::argBinary)
+			format = Format::binary;
+		else if (arg == Default::argOutput) {
+			if (++i == argc)
+				return false;
+			output = argv[i];
+		} else
+			vals.push_back(arg);
+	}
+	if (vals.size() != 4)
+		return false;
+
+	func = vals[0];
+	try {
+		start = stod(vals[1]);
+		end = stod(vals[2]);
+		step = stod(vals[3]);
+	} catch (...) {
+		return false;
+	}
+	if (!std::isfinite(start) || !std::isfinite(end) || !(step > 0.0) || !std::isfinite(step) || end < start) {
+		cerr << "range has to be finite with start <= end and step > 0" << endl;
+		return false;
+	}
+	return !func.empty();
+}
+
+bool Batch::setExpression(Expression& expr, Parser& parser) const {
+	// the users file has to be read either way because the function might use it's variables
+	map<string, double> vars;
+	vector<Function> funcs = Filer::loadUsers(vars);
+	parser.updateVars(vars);
+
+	string text = func;
+	if (func[0] == '#') {
+		sizt id;
+		try {
+			id = std::stoul(func.substr(1));
+		} catch (...) {
+			id = funcs.size();
+		}
+		if (id >= funcs.size()) {
+			cerr << "there's no function " << func << " in " << Default::fileUsers << " (it has " << funcs.size() << ')' << endl;
+			return false;
+		}
+		text = funcs[id].text;
+	}
+	if (!expr.set(parser, text)) {
+		cerr << "invalid function " << text << endl;
+		return false;
+	}
+	if (expr.implicit()) {
+		cerr << text << " is a curve of x and y, which can't be evaluated over a range of x" << endl;
+		return false;
+	}
+	return true;
+}
+
+int Batch::evaluate(const Expression& expr, const Parser& parser, FILE* file) const {
+	// x values are calculated from their index so that errors don't add up over long ranges
+	sizt count = sizt(std::floor((end - start) / step + 1e-9)) + 1;
+
+	// only two blocks are kept in memory: one gets solved while the other one is being written
+	Sampler sampler;
+	vector<double> xs[2], ys[2];
+	for (uint8 i=0; i<2; i++) {
+		xs[i].resize(std::min(count, Default::batchBlock));
+		ys[i].resize(xs[i].size());
+	}
+	std::future<void> writer;
+	for (sizt pos=0, b=0; pos<count; pos+=Default::batchBlock, b^=1) {
+		sizt n = std::min(count - pos, Default::batchBlock);
+		for (sizt i=0; i<n; i++)
+			xs[b][i] = start + double(pos + i) * step;
+		sampler.sample(expr.getCode(), xs[b].data(), vector<double*>(1, ys[b].data()), n, parser.getVars());
+
+		if (writer.valid())
+			writer.get();
+		if (ferror(file))
+			break;
+		writer = std::async(std::launch::async, write, file, format, std::cref(xs[b]), std::cref(ys[b]), n);
+	}
+	if (writer.valid())
+		writer.get();
+
+	if (fflush(file) || ferror(file)) {
+		cerr << "failed to write output" << endl;
+		return 1;
+	}
+	return 0;
+}
+
+void Batch::write(FILE* file, Format format, const vector<double>& xs, const vector<double>& ys, sizt n) {
+	if (format == Format::binary) {
+		vector<double> pairs(n * 2);
+		for (sizt i=0; i<n; i++) {
+			pairs[i*2] = xs[i];
+			pairs[i*2+1] = ys[i];
+		}
+		fwrite(pairs.data(), sizeof(double), pairs.size(), file);
+	} else {
+		char line[64];
+		for (sizt i=0; i<n; i++) {
+			int len = snprintf(line, sizeof(line), "%.17g,%.17g\n", xs[i], ys[i]);
+			fwrite(line, 1, sizt(len), file);
+		}
+	}
+}
+
+void Batch::printUsage() {
+	cerr << "usage: BKGraph " << Default::argEval << " <function> <start> <end> <step> [" << Default::argCsv << " | " << Default::argBinary << "] [" << Default::argOutput << " <file>]" << endl
+		<< "  <function>  text of a function or '#' followed by the index of a function in " << Default::fileUsers << " (starting at 0)" << endl
+		<< "  " << Default::argCsv << "       write \"x,y\" lines (default)" << endl
+		<< "  " << Default::argBinary << "    write pairs of doubles in the machine's byte order" << endl
+		<< "  " << Default::argOutput << "          write to a file instead of stdout" << endl;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "utils/functions.h"
+#include "utils/parser.h"
+#include "utils/sampler.h"
+
+// evaluates a function over a range of x values without opening a window and streams the results to a file or stdout
+class Batch {
+public:
+	enum class Format : uint8 {
+		csv,	// "x,y" lines
+		binary	// pairs of doubles (x and y) in the machine's byte order
+	};
+
+	static bool wanted(int argc, char** argv);	// whether the command line asks for batch mode
+	static int run(int argc, char** argv);		// returns the program's exit code
+
+private:
+	string func;	// text of the function or '#' followed by the index of a function in the users file
+	double start, end, step;
+	Format format;
+	string output;	// file to write to (stdout if empty)
+
+	Batch();
+
+	bool readArgs(int argc, char** argv);
+	bool setExpression(Expression& expr, Parser& parser) const;
+	int evaluate(const Expression& expr, const Parser& parser, FILE* file) const;
+	static void write(FILE* file, Format format, const vector<double>& xs, const vector<double>& ys, sizt n);
+	static void printUsage();
+};
@@ -1,6 +1,8 @@
 #include "world.h"
 
-DrawSys::DrawSys(SDL_Window* window, int driverIndex)
+DrawSys::DrawSys(SDL_Window* window, int driverIndex) :
+	graphLayer(nullptr),
+	graphLayerValid(false)
 {
 	renderer = SDL_CreateRenderer(window, driverIndex, Default::rendererFlags);
 	if (!renderer)
@@ -9,6 +11,8 @@ DrawSys::DrawSys(SDL_Window* window, int driverIndex)
 }
 
 DrawSys::~DrawSys() {
+	clearTexts();
+	clearGraphLayer();
 	SDL_DestroyRenderer(renderer);
 }
 
@@ -70,37 +74,173 @@ void DrawSys::drawLabel(Label* wgt) {
 }
 
 void DrawSys::drawGraphView(GraphView* wgt) {
-	vec2i pos = wgt->position();
+	// draw straight to the window if the renderer can't draw to textures
+	SDL_Rect rect = wgt->rect();
+	if (!SDL_RenderTargetSupported(renderer)) {
+		SDL_RenderSetViewport(renderer, &rect);
+		drawGraphs(wgt);
+		SDL_RenderSetViewport(renderer, nullptr);
+		return;
+	}
+
+	// make a new layer if the size changed
+	vec2i siz;
+	if (graphLayer)
+		SDL_QueryTexture(graphLayer, nullptr, nullptr, &siz.x, &siz.y);
+	if (!graphLayer || siz != vec2i(rect.w, rect.h)) {
+		clearGraphLayer();
+		graphLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, rect.w, rect.h);
+		if (!graphLayer)
+			return;
+	}
+
+	// redraw layer (undimmed with background) only if graphs have changed
+	if (!graphLayerValid) {
+		SDL_Color dim = colorDim;
+		colorDim = Default::colorNoDim;
+		SDL_SetRenderTarget(renderer, graphLayer);
+		SDL_SetRenderDrawColor(renderer, Default::colorBackground.r, Default::colorBackground.g, Default::colorBackground.b, Default::colorBackground.a);
+		SDL_RenderClear(renderer);
+		drawGraphs(wgt);
+		SDL_SetRenderTarget(renderer, nullptr);
+		colorDim = dim;
+		graphLayerValid = true;
+	}
+
+	// dim by color mod instead
+	SDL_SetTextureColorMod(graphLayer, 255 / colorDim.r, 255 / colorDim.g, 255 / colorDim.b);
+	SDL_RenderCopy(renderer, graphLayer, nullptr, &rect);
+}
+
+void DrawSys::clearGraphLayer() {
+	if (graphLayer) {
+		SDL_DestroyTexture(graphLayer);
+		graphLayer = nullptr;
+	}
+	graphLayerValid = false;
+}
+
+void DrawSys::drawGraphs(GraphView* wgt) {
+	// everything gets drawn relative to the GraphView
 	vec2i siz = wgt->size();
-	int endy = pos.y + siz.y;
+	SDL_Rect frame = {0, 0, siz.x, siz.y};
 
 	// draw lines
-	vec2i lstt = vec2i(dotToPix(vec2f(World::winSys()->getSettings().viewPos.x, 0.f), World::winSys()->getSettings().viewPos, World::winSys()->getSettings().viewSize, vec2f(siz))) + pos;
-	drawLine(lstt, vec2i(lstt.x + siz.x - 1, lstt.y), Default::colorGraph, {pos.x, pos.y, siz.x, siz.y});
+	vec2i lstt = vec2i(dotToPix(vec2f(World::winSys()->getSettings().viewPos.x, 0.f), World::winSys()->getSettings().viewPos, World::winSys()->getSettings().viewSize, vec2f(siz)));
+	drawLine(lstt, vec2i(lstt.x + siz.x - 1, lstt.y), Default::colorGraph, frame);
 
-	lstt = vec2i(dotToPix(vec2f(0.f, World::winSys()->getSettings().viewPos.y), World::winSys()->getSettings().viewPos, World::winSys()->getSettings().viewSize, vec2f(siz))) + pos;
-	drawLine(lstt, vec2i(lstt.x, lstt.y + siz.y - 1), Default::colorGraph, {pos.x, pos.y, siz.x, siz.y});
+	lstt = vec2i(dotToPix(vec2f(0.f, World::winSys()->getSettings().viewPos.y), World::winSys()->getSettings().viewPos, World::winSys()->getSettings().viewSize, vec2f(siz)));
+	drawLine(lstt, vec2i(lstt.x, lstt.y + siz.y - 1), Default::colorGraph, frame);
 
-	// draw graphs
+	// draw graphs (their first and last dots lie a bit outside the view, but the viewport or texture cuts them off)
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	vector<SDL_Vertex> verts;
+	vector<int> ids;
+#endif
 	for (const Graph& it : wgt->getGraphs()) {
 		SDL_Color color = dimColor(World::program()->getFunction(it.fid).color);
 		SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
 
+		// get spans of dots that are in view and aren't separated by a jump
+		vector<vec2t> spans;
 		sizt start;
 		bool lastIn = false;
-		for (sizt x=0; x<it.pixs.size(); x++) {
-			bool curIn = inRange(it.pixs[x].y, pos.y, endy);
-			if (curIn) {
-				if (!lastIn)
-					start = x;
-			} else if (lastIn)
-				SDL_RenderDrawLines(renderer, &it.pixs[start], x-start);
+		for (sizt x=0; x<it.pixs.size() && !it.implicit; x++) {
+			bool curIn = inRange(it.pixs[x].y, 0.f, float(siz.y));
+			bool cut = x && x <= it.cuts.size() && it.cuts[x-1];
+			if (lastIn && (!curIn || cut))
+				spans.push_back(vec2t(start, x));
+			if (curIn && (!lastIn || cut))
+				start = x;
 			lastIn = curIn;
 		}
 		if (lastIn)
-			SDL_RenderDrawLines(renderer, &it.pixs[start], it.pixs.size()-start);
+			spans.push_back(vec2t(start, it.pixs.size()));
+		for (sizt x=0; x+1<it.pixs.size() && it.implicit; x+=2)	// each segment of a curve is it's own span
+			spans.push_back(vec2t(x, x + 2));
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+		// all spans of a graph get drawn at once
+		verts.clear();
+		ids.clear();
+		for (const vec2t& sp : spans)
+			addGraphLine(verts, ids, &it.pixs[sp.l], sp.u - sp.l, color);
+		if (!ids.empty())
+			SDL_RenderGeometry(renderer, nullptr, verts.data(), verts.size(), ids.data(), ids.size());
+#else
+		for (const vec2t& sp : spans) {
+			vector<SDL_Point> pnts(sp.u - sp.l);
+			for (sizt i=0; i<pnts.size(); i++)
+				pnts[i] = {int(it.pixs[sp.l+i].x), int(it.pixs[sp.l+i].y)};
+			SDL_RenderDrawLines(renderer, pnts.data(), pnts.size());
+		}
+#endif
+		// draw markers as squares (filled ones for roots and hollow ones for extrema) or as crosses for crossings
+		for (sizt i=0; i<it.markers.size(); i++) {
+			SDL_Rect box = {it.markerPixs[i].x - Default::markerSize / 2, it.markerPixs[i].y - Default::markerSize / 2, Default::markerSize, Default::markerSize};
+			if (it.markers[i].type == Marker::Type::crossing) {
+				SDL_RenderDrawLine(renderer, box.x, box.y, box.x + box.w - 1, box.y + box.h - 1);
+				SDL_RenderDrawLine(renderer, box.x, box.y + box.h - 1, box.x + box.w - 1, box.y);
+			} else if (it.markers[i].type == Marker::Type::extremum)
+				SDL_RenderDrawRect(renderer, &box);
+			else
+				SDL_RenderFillRect(renderer, &box);
+		}
+	}
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+void DrawSys::addGraphLine(vector<SDL_Vertex>& verts, vector<int>& ids, const vec2f* pixs, sizt cnt, SDL_Color color) {
+	if (cnt < 2)
+		return;
+
+	float hwidth = World::winSys()->getSettings().lineWidth / 2.f;
+	SDL_Color edge = {color.r, color.g, color.b, 0};
+
+	// the start of the line has no segment before it, so it takes the direction of the first segment that has a length
+	vec2f lastDir(1.f, 0.f);
+	for (sizt i=1; i<cnt; i++)
+		if ((pixs[i] - pixs[0]).length() > 0.f) {
+			lastDir = (pixs[i] - pixs[0]).normalize();
+			break;
+		}
+
+	for (sizt i=0; i<cnt; i++) {
+		// get directions of the segments before and after the dot (segments of zero length take the previous direction)
+		vec2f pos = pixs[i];
+		vec2f prev = i ? pos - pixs[i-1] : vec2f(0.f);
+		vec2f next = (i + 1 < cnt) ? pixs[i+1] - pos : vec2f(0.f);
+		vec2f din = (prev.length() > 0.f) ? prev.normalize() : lastDir;
+		vec2f dout = (next.length() > 0.f) ? next.normalize() : din;
+		lastDir = dout;
+
+		// miter the corner, so that neighboring segments share their vertices
+		vec2f nrm(-dout.y, dout.x);
+		vec2f sum = din + dout;
+		vec2f ofs = nrm;
+		if (sum.length() > 0.f) {
+			vec2f mit = vec2f(-sum.y, sum.x).normalize();
+			float cosine = mit.dot(nrm);
+			ofs = mit / std::max(cosine, 1.f / Default::graphMiterLimit);
+		}
+
+		// four vertices across the line: outer edge, inner edge, inner edge, outer edge
+		int base = verts.size();
+		vec2f inner = ofs * hwidth, outer = ofs * (hwidth + Default::graphFeather);
+		verts.push_back({{pos.x - outer.x, pos.y - outer.y}, edge, {0.f, 0.f}});
+		verts.push_back({{pos.x - inner.x, pos.y - inner.y}, color, {0.f, 0.f}});
+		verts.push_back({{pos.x + inner.x, pos.y + inner.y}, color, {0.f, 0.f}});
+		verts.push_back({{pos.x + outer.x, pos.y + outer.y}, edge, {0.f, 0.f}});
+
+		// connect them to the previous ones with three quads
+		if (i)
+			for (int k=0; k<3; k++) {
+				int a = base - 4 + k, b = base + k;
+				ids.insert(ids.end(), {a, a + 1, b, a + 1, b + 1, b});
+			}
 	}
 }
+#endif
 
 void DrawSys::drawScrollArea(ScrollArea* box) {
 	// get index interval of items on screen and draw children
@@ -145,18 +285,56 @@ void DrawSys::drawLine(vec2i pos, vec2i end, SDL_Color color, const SDL_Rect& fr
 
 void DrawSys::drawText(const string& text, const vec2i& pos, int height, SDL_Color color, const SDL_Rect& frame) {
 	// get text texture
-	SDL_Surface* surf = TTF_RenderUTF8_Blended(World::winSys()->getFontSet().getFont(height), text.c_str(), dimColor(color));
-	SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
+	const Text* txt = getText(text, height);
+	if (!txt)
+		return;
 
 	// crop destination rect and original texture rect
-	SDL_Rect dst = {pos.x, pos.y, surf->w, surf->h};
+	SDL_Rect dst = {pos.x, pos.y, txt->size.x, txt->size.y};
 	SDL_Rect crop = cropRect(dst, frame);
-	SDL_Rect src = {crop.x, crop.y, surf->w - crop.w, surf->h - crop.h};
+	SDL_Rect src = {crop.x, crop.y, txt->size.x - crop.w, txt->size.y - crop.h};
 
-	// draw and cleanup
-	SDL_RenderCopy(renderer, tex, &src, &dst);
-	SDL_DestroyTexture(tex);
+	// draw in the requested color
+	color = dimColor(color);
+	SDL_SetTextureColorMod(txt->tex, color.r, color.g, color.b);
+	SDL_SetTextureAlphaMod(txt->tex, color.a);
+	SDL_RenderCopy(renderer, txt->tex, &src, &dst);
+}
+
+void DrawSys::clearTexts() {
+	for (Text& it : texts)
+		SDL_DestroyTexture(it.tex);
+	texts.clear();
+	textIds.clear();
+}
+
+const DrawSys::Text* DrawSys::getText(const string& text, int height) {
+	// move text to the front if it has already been rendered
+	TextKey key(text, height);
+	umap<TextKey, std::list<Text>::iterator, TextKeyHash>::iterator it = textIds.find(key);
+	if (it != textIds.end()) {
+		texts.splice(texts.begin(), texts, it->second);
+		return &texts.front();
+	}
+
+	// otherwise render it in white, so that it can be drawn in any color
+	SDL_Surface* surf = TTF_RenderUTF8_Blended(World::winSys()->getFontSet().getFont(height), text.c_str(), {255, 255, 255, 255});
+	if (!surf)
+		return nullptr;
+	Text txt = {key, SDL_CreateTextureFromSurface(renderer, surf), vec2i(surf->w, surf->h)};
 	SDL_FreeSurface(surf);
+	if (!txt.tex)
+		return nullptr;
+
+	// add it and get rid of the least recently drawn text if there's too many
+	texts.push_front(txt);
+	textIds.insert(make_pair(key, texts.begin()));
+	if (texts.size() > Default::textCacheSize) {
+		SDL_DestroyTexture(texts.back().tex);
+		textIds.erase(texts.back().key);
+		texts.pop_back();
+	}
+	return &texts.front();
 }
 
 SDL_Color DrawSys::dimColor(SDL_Color color) {
@@ -3,6 +3,7 @@
 #include "widgets/context.h"
 #include "widgets/layouts.h"
 #include "widgets/graphView.h"
+#include <list>
 
 // handles the drawing
 class DrawSys {
@@ -24,10 +25,42 @@ public:
 	void drawRect(const SDL_Rect& rect, SDL_Color color);
 	void drawLine(vec2i pos, vec2i end, SDL_Color color, const SDL_Rect& frame);
 	void drawText(const string& text, const vec2i& pos, int height, SDL_Color color, const SDL_Rect& frame);
+	void clearTexts();	// needs to be called when the font changes
+	void redrawGraphs() { graphLayerValid = false; }	// needs to be called when anything in a GraphView changes
+	void clearGraphLayer();
 
 private:
+	// rendered text that can be reused for as long as it's being drawn
+	struct TextKey {
+		TextKey(const string& TXT, int HGT) : text(TXT), height(HGT) {}
+
+		bool operator==(const TextKey& key) const { return height == key.height && text == key.text; }
+
+		string text;
+		int height;
+	};
+
+	struct TextKeyHash {
+		sizt operator()(const TextKey& key) const { return std::hash<string>()(key.text) * 31 + sizt(key.height); }
+	};
+
+	struct Text {
+		TextKey key;
+		SDL_Texture* tex;	// white text that gets colored when drawn
+		vec2i size;
+	};
+
 	SDL_Renderer* renderer;
 	SDL_Color colorDim;		// currenly used for dimming background widgets when popup is displayed (dimming is achieved through division)
+	SDL_Texture* graphLayer;	// rendered GraphView, which gets reused until the graphs change
+	bool graphLayerValid;
+	std::list<Text> texts;	// most recently drawn text is at the front
+	umap<TextKey, std::list<Text>::iterator, TextKeyHash> textIds;	// for finding texts in the list
 
 	SDL_Color dimColor(SDL_Color color);
+	void drawGraphs(GraphView* wgt);
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	void addGraphLine(vector<SDL_Vertex>& verts, vector<int>& ids, const vec2f* pixs, sizt cnt, SDL_Color color);	// turns a line into triangles with fading edges
+#endif
+	const Text* getText(const string& text, int height);	// returns nullptr if the text can't be rendered
 };
@@ -107,6 +107,8 @@ void IniLine::clear() {
 // FILER
 
 const string Filer::dirExec = Filer::getDirExec();
+umap<string, string> Filer::fontIndex;
+vector<pair<string, int64>> Filer::fontDirs;
 #ifdef _WIN32
 const vector<string> Filer::dirFonts = {Filer::dirExec, string(std::getenv("SystemDrive")) + "\\Windows\\Fonts\\"};
 #else
@@ -140,6 +142,8 @@ Settings Filer::loadSettings() {
 			sets.setViewport(il.getVal());
 		else if (il.getArg() == Default::iniKeywordScrollSpeed)
 			sets.scrollSpeed = stoi(il.getVal());
+		else if (il.getArg() == Default::iniKeywordLineWidth)
+			sets.lineWidth = stof(il.getVal());
 	}
 	return sets;
 }
@@ -152,7 +156,8 @@ void Filer::saveSettings(const Settings& sets) {
 		IniLine(Default::iniKeywordFullscreen, btos(sets.fullscreen)).line(),
 		IniLine(Default::iniKeywordResolution, sets.getResolutionString()).line(),
 		IniLine(Default::iniKeywordViewport, sets.getViewportString()).line(),
-		IniLine(Default::iniKeywordScrollSpeed, ntos(sets.scrollSpeed)).line()
+		IniLine(Default::iniKeywordScrollSpeed, ntos(sets.scrollSpeed)).line(),
+		IniLine(Default::iniKeywordLineWidth, ntos(sets.lineWidth)).line()
 	};
 	writeTextFile(dirExec + Default::fileSettings, lines);
 }
@@ -175,6 +180,23 @@ vector<Function> Filer::loadUsers(map<string, double>& vars) {
 		} else if (il.getArg() == Default::iniKeywordFunction)
 			funcs.push_back(Function(il.getVal()));
 	}
+
+	// variables from older versions can have names that are built-in words now, in which case they and their uses in functions get renamed
+	for (map<string, double>::iterator it=vars.begin(); it!=vars.end();) {
+		if (!Default::parserConsts.count(it->first) && !Default::parserFuncs.count(it->first)) {
+			it++;
+			continue;
+		}
+
+		string name = it->first + '_';
+		while (vars.count(name) || Default::parserConsts.count(name) || Default::parserFuncs.count(name))
+			name += '_';
+		cerr << "variable \"" << it->first << "\" has the name of a built-in word and got renamed to \"" << name << '"' << endl;
+		for (Function& fit : funcs)
+			fit.text = renameWord(fit.text, it->first, name);
+		vars.insert(make_pair(name, it->second));
+		it = vars.erase(it);
+	}
 	return funcs;
 }
 
@@ -337,6 +359,20 @@ bool Filer::fileExists(const string& path) {
 #endif
 }
 
+int64 Filer::modTime(const string& path) {
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesExW(stow(path).c_str(), GetFileExInfoStandard, &data))
+		return 0;
+	return (int64(data.ftLastWriteTime.dwHighDateTime) << 32) | int64(data.ftLastWriteTime.dwLowDateTime);
+#else
+	struct stat ps;
+	if (stat(path.c_str(), &ps))
+		return 0;
+	return int64(ps.st_mtime);
+#endif
+}
+
 vector<char> Filer::listDrives() {
 	vector<char> letters;
 #ifdef _WIN32
@@ -352,13 +388,115 @@ string Filer::findFont(const string& font) {
 	if (isAbsolute(font) && fileExists(font) && fileType(font) == FTYPE_FILE)	// check if font refers to a file
 		return font;
 	
-	for (const string& dir : dirFonts)	// check font directories
-		for (string& it : listDirRecursively(dir))
-			if (strcmpCI(hasExtension(it) ? delExtension(filename(it)) : filename(it), font))
-				return dir + it;
+	// the index is read once and only gets rebuilt if it's missing, out of date or doesn't know the font even though a font directory has changed
+	if (fontDirs.empty() && (!loadFontIndex() || !fontIndexValid())) {
+		indexFonts();
+		saveFontIndex();
+	}
+	umap<string, string>::iterator it = fontIndex.find(lowercase(font));
+	if (it != fontIndex.end())
+		return it->second;
+
+	if (!fontIndexValid()) {
+		indexFonts();
+		saveFontIndex();
+		it = fontIndex.find(lowercase(font));
+		if (it != fontIndex.end())
+			return it->second;
+	}
 	return "";	// nothing found
 }
 
+bool Filer::loadFontIndex() {
+	fontIndex.clear();
+	fontDirs.clear();
+	vector<string> lines;
+	if (!readTextFile(dirExec + Default::fileFonts, lines))
+		return false;
+
+	for (string& line : lines) {
+		IniLine il;
+		if (!il.setLine(line))
+			continue;
+
+		// font names can contain anything, so they aren't stored as keys but taken from the paths again
+		if (il.getType() == IniLine::Type::argKeyVal && il.getArg() == Default::iniKeywordDirectory)
+			fontDirs.push_back(make_pair(il.getVal(), int64(stoll(il.getKey()))));
+		else if (il.getType() == IniLine::Type::argVal && il.getArg() == Default::iniKeywordFont)
+			fontIndex.insert(make_pair(fontName(il.getVal()), il.getVal()));
+	}
+	return !fontDirs.empty() && !fontIndex.empty();	// an index without fonts might be in the old format, so it's safer to rebuild it
+}
+
+void Filer::saveFontIndex() {
+	vector<string> lines;
+	for (const pair<string, int64>& it : fontDirs)
+		lines.push_back(IniLine(Default::iniKeywordDirectory, ntos(it.second), it.first).line());
+	for (const pair<const string, string>& it : fontIndex)
+		lines.push_back(IniLine(Default::iniKeywordFont, it.second).line());
+	writeTextFile(dirExec + Default::fileFonts, lines);
+}
+
+bool Filer::fontIndexValid() {
+	// all font directories need to have been scanned
+	for (const string& dir : dirFonts) {
+		bool found = false;
+		for (const pair<string, int64>& it : fontDirs)
+			if (it.first == dir) {
+				found = true;
+				break;
+			}
+		if (!found)
+			return false;
+	}
+
+	// adding or removing files or directories changes the modification time of their parent directory
+	for (const pair<string, int64>& it : fontDirs)
+		if (modTime(it.first) != it.second)
+			return false;
+	return true;
+}
+
+void Filer::indexFonts() {
+	fontIndex.clear();
+	fontDirs.clear();
+	for (const string& dir : dirFonts)
+		indexFontDir(dir);
+}
+
+void Filer::indexFontDir(const string& dir) {
+	fontDirs.push_back(make_pair(dir, modTime(dir)));
+	vector<string> dirs = listDir(dir, FTYPE_DIR);
+	for (string& it : listDir(dir, FTYPE_FILE))
+		if (!std::binary_search(dirs.begin(), dirs.end(), it))
+			fontIndex.insert(make_pair(fontName(it), dir + it));	// files that come first take precedence
+	for (string& it : dirs)
+		indexFontDir(dir + it + dsep);
+}
+
+string Filer::fontName(const string& path) {
+	string file = filename(path);
+	return lowercase(hasExtension(file) ? delExtension(file) : file);
+}
+
+string Filer::renameWord(const string& text, const string& word, const string& name) {
+	string out;
+	for (sizt i=0; i<text.length();) {
+		if (!isLetter(text[i])) {
+			out += text[i++];
+			continue;
+		}
+
+		// words are whole runs of letters like in Parser
+		sizt end = i;
+		while (end < text.length() && isLetter(text[end]))
+			end++;
+		out += (text.compare(i, end - i, word) == 0) ? name : text.substr(i, end - i);
+		i = end;
+	}
+	return out;
+}
+
 string Filer::getDirExec() {
 	string path;
 #ifdef _WIN32
@@ -66,14 +66,25 @@ public:
 	static vector<string> listDirRecursively(const string& dir) { return listDirRecursively(dir, dir.length()); }
 	static FileType fileType(const string& path);
 	static bool fileExists(const string& path);		// can be used for directories
+	static int64 modTime(const string& path);		// last modification time or 0 if path doesn't exist
 
 	static vector<char> listDrives();	// get list of drive letters under windows
-	static string findFont(const string& font);	// on success returns absolute path to font file, otherwise returns empty path
+	static string findFont(const string& font);	// on success returns absolute path to font file, otherwise returns empty path (looks up fontIndex, which only gets rebuilt if fonts have changed)
 	
 	static const string dirExec;	// directory in which the executable should currently be
 	static const vector<string> dirFonts;	// os's font directories
 
 private:
+	static umap<string, string> fontIndex;			// font file paths by lowercase file name without extension
+	static vector<pair<string, int64>> fontDirs;	// all scanned font directories and their modification times at the time of scanning
+
+	static bool loadFontIndex();	// returns false if the index file couldn't be read
+	static void saveFontIndex();
+	static bool fontIndexValid();	// checks if any font directory has changed
+	static string fontName(const string& path);	// name that a font file gets looked up by (lowercase file name without extension)
+	static void indexFonts();		// scans font directories
+	static void indexFontDir(const string& dir);
+	static string renameWord(const string& text, const string& word, const string& name);	// replaces every whole word in text that matches word with name
 	static string getDirExec();		// for setting dirExec
 	static std::istream& readLine(std::istream& ifs, string& str);
 };
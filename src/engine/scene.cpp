@@ -21,8 +21,10 @@ void Scene::onKeypress(const SDL_KeyboardEvent& key) {
 void Scene::onMouseMove(const vec2i& mPos, const vec2i& mMov) {
 	updateFocused(mPos);
 
-	if (capture)
+	if (capture) {
 		capture->onDrag(mPos, mMov);
+		World::winSys()->setRedraw();
+	}
 }
 
 void Scene::onMouseDown(const vec2i& mPos, uint8 mBut) {
@@ -56,9 +58,14 @@ void Scene::onResize() {
 		popup->onResize();
 }
 
+void Scene::onTick() {
+	layout->onTick();
+	if (popup)
+		popup->onTick();
+}
+
 void Scene::setLayout(Layout* newLayout) {
 	// clear scene
-	World::winSys()->getFontSet().clear();
 	setCapture(nullptr);
 	popup.reset();
 	context.reset();
@@ -66,12 +73,14 @@ void Scene::setLayout(Layout* newLayout) {
 	// set stuff up
 	layout.reset(newLayout);
 	setFocused(WindowSys::mousePos());
+	World::winSys()->setRedraw();
 }
 
 void Scene::setPopup(Popup* newPopup, Widget* newCapture) {
 	popup.reset(newPopup);
 	setCapture(newCapture);
 	setFocused(WindowSys::mousePos());
+	World::winSys()->setRedraw();
 }
 
 void Scene::setContext(Context* newContext) {
@@ -81,6 +90,7 @@ void Scene::setContext(Context* newContext) {
 		correctContextPos(context->position.x, context->getSize().x, res.x);
 		correctContextPos(context->position.y, context->height(), res.y);
 	}
+	World::winSys()->setRedraw();
 }
 
 void Scene::correctContextPos(int& pos, int size, int res) {
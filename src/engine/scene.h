@@ -15,6 +15,7 @@ public:
 	void onMouseWheel(int wMov);
 	void onText(const char* text);
 	void onResize();
+	void onTick();
 
 	Layout* getLayout() { return layout.get(); }
 	void setLayout(Layout* newLayout);
@@ -1,12 +1,27 @@
 #include "windowSys.h"
 #include "filer.h"
 
+// LATENCY
+
+void Latency::add(uint32 ms) {
+	last = ms;
+	if (ms > max)
+		max = ms;
+	total += ms;
+	frames++;
+}
+
+// WINDOW SYS
+
 WindowSys::WindowSys() :
 	window(nullptr),
-	run(false)
+	run(false),
+	redraw(true),
+	inputPending(false),
+	inputStamp(0)
 {}
 
-int WindowSys::start() {
+int WindowSys::start(bool report) {
 	// initialize all components
 	try {
 		if (SDL_Init(SDL_INIT_VIDEO))
@@ -32,23 +47,28 @@ int WindowSys::start() {
 
 	// the loop :O
 	while (run) {
-		// draw scene
-		drawSys->drawWidgets();
-
-		// poll events
-		SDL_Event event;
-		uint32 timeout = SDL_GetTicks() + Default::eventCheckTimeout;
-		while (SDL_PollEvent(&event) && SDL_GetTicks() < timeout)
-			handleEvent(event);
+		// let widgets continue unfinished work and draw scene if anything changed
+		scene->onTick();
+		if (redraw) {
+			redraw = false;
+			drawSys->drawWidgets();
+			if (inputPending) {
+				latency.add(SDL_GetTicks() - inputStamp);
+				inputPending = false;
+			}
+		}
+		handleEvents();
 	}
+	if (report && latency.frames)
+		cout << "input latency: " << latency.total / latency.frames << "ms average, " << latency.max << "ms max over " << latency.frames << " frames" << endl;
 
 	// save changes
 	Filer::saveUsers(program->getFunctions(), program->getVariables());
 	Filer::saveSettings(sets);
 
-	// cleanup
-	program.reset();
+	// cleanup (the scene goes first because GraphView's plotter thread uses the program's sampler)
 	scene.reset();
+	program.reset();
 	destroyWindow();
 
 	TTF_Quit();
@@ -81,6 +101,7 @@ void WindowSys::createWindow() {
 
 	// set up renderer
 	drawSys.reset(new DrawSys(window, sets.getRenderDriverIndex()));
+	redraw = true;
 }
 
 void WindowSys::destroyWindow() {
@@ -91,12 +112,49 @@ void WindowSys::destroyWindow() {
 	}
 }
 
+void WindowSys::handleEvents() {
+	// sleep until there's something to do
+	SDL_Event event;
+	if (!SDL_WaitEventTimeout(&event, Default::eventWaitTimeout))
+		return;
+
+	// handle all waiting events, but merge mouse motion so that dragging updates things only once
+	vec2i mPos, mMov;
+	bool moved = false;
+	uint32 timeout = SDL_GetTicks() + Default::eventCheckTimeout;
+	do {
+		if (!inputPending && (event.type == SDL_KEYDOWN || event.type == SDL_MOUSEMOTION || event.type == SDL_MOUSEBUTTONDOWN || event.type == SDL_MOUSEBUTTONUP || event.type == SDL_MOUSEWHEEL || event.type == SDL_TEXTINPUT)) {
+			inputPending = true;
+			inputStamp = event.common.timestamp;
+		}
+
+		if (event.type == SDL_MOUSEMOTION) {
+			mMov = moved ? mMov + vec2i(event.motion.xrel, event.motion.yrel) : vec2i(event.motion.xrel, event.motion.yrel);
+			mPos = vec2i(event.motion.x, event.motion.y);
+			moved = true;
+		} else {
+			if (moved) {	// other events need to see the mouse where it was when they happened
+				scene->onMouseMove(mPos, mMov);
+				moved = false;
+			}
+			handleEvent(event);
+		}
+	} while (SDL_GetTicks() < timeout && SDL_PollEvent(&event));
+	if (moved)
+		scene->onMouseMove(mPos, mMov);
+
+	if (!redraw)	// input that didn't change anything doesn't get a frame
+		inputPending = false;
+}
+
 void WindowSys::handleEvent(const SDL_Event& event) {
+	// everything but waking up can change what's on screen (mouse motion gets handled by Scene)
+	if (event.type != SDL_USEREVENT)
+		redraw = true;
+
 	// pass event to whatever part of the program is supposed to handle it
 	if (event.type == SDL_KEYDOWN)
 		scene->onKeypress(event.key);
-	else if (event.type == SDL_MOUSEMOTION)
-		scene->onMouseMove(vec2i(event.motion.x, event.motion.y), vec2i(event.motion.xrel, event.motion.yrel));
 	else if (event.type == SDL_MOUSEBUTTONDOWN)
 		scene->onMouseDown(vec2i(event.button.x, event.button.y), event.button.button);
 	else if (event.type == SDL_MOUSEBUTTONUP)
@@ -107,6 +165,12 @@ void WindowSys::handleEvent(const SDL_Event& event) {
 		scene->onText(event.text.text);
 	else if (event.type == SDL_WINDOWEVENT)
 		eventWindow(event.window);
+	else if (event.type == SDL_RENDER_TARGETS_RESET)	// the graph layer's contents are gone
+		drawSys->redrawGraphs();
+	else if (event.type == SDL_RENDER_DEVICE_RESET) {	// all textures are gone
+		drawSys->clearTexts();
+		drawSys->clearGraphLayer();
+	}
 	else if (event.type == SDL_QUIT)
 		close();
 }
@@ -133,6 +197,13 @@ vec2i WindowSys::resolution() const {
 	return res;
 }
 
+void WindowSys::wakeUp() {
+	SDL_Event event;
+	SDL_zero(event);
+	event.type = SDL_USEREVENT;
+	SDL_PushEvent(&event);
+}
+
 vec2i WindowSys::mousePos() {
 	vec2i pos;
 	SDL_GetMouseState(&pos.x, &pos.y);
@@ -178,6 +249,12 @@ void WindowSys::setFullscreen(bool on) {
 
 void WindowSys::setFont(const string& font) {
 	sets.setFont(font);
+	drawSys->clearTexts();	// already rendered texts use the old font
+}
+
+void WindowSys::setLineWidth(float lw) {
+	sets.lineWidth = lw;
+	drawSys->redrawGraphs();
 }
 
 void WindowSys::resetSettings() {
@@ -5,13 +5,26 @@
 #include "prog/program.h"
 #include "utils/settings.h"
 
+// time from user input until the frame that shows it's effect gets presented
+struct Latency {
+	Latency() : last(0), max(0), total(0), frames(0) {}
+
+	void add(uint32 ms);
+
+	uint32 last, max;	// in milliseconds
+	uint64 total;
+	uint32 frames;
+};
+
 // runs and kills everything, passes events, handles window events and contains settings
 class WindowSys {
 public:
 	WindowSys();
 
-	int start();
+	int start(bool report=false);	// report is whether to print the input latency on exit
 	void close() { run = false; }
+	void setRedraw() { redraw = true; }	// the window only gets redrawn if something changed
+	static void wakeUp();	// makes the loop stop waiting for events (can be called from any thread)
 	
 	vec2i resolution() const;
 	static vec2i mousePos();
@@ -33,6 +46,7 @@ public:
 	void setFullscreen(bool on);
 	void setFont(const string& font);
 	void setScrollSpeed(int ss) { sets.scrollSpeed = ss; }
+	void setLineWidth(float lw);
 	void resetSettings();
 
 private:
@@ -43,10 +57,15 @@ private:
 
 	Settings sets;
 	bool run;		// whether the loop in which the program runs should continue
+	bool redraw;	// whether anything has changed since the last frame
+	bool inputPending;	// whether there's been input that hasn't been presented yet
+	uint32 inputStamp;	// time of the first of that input
+	Latency latency;
 	
 	void createWindow();
 	void destroyWindow();
 	
+	void handleEvents();	// wait for events and handle the ones that came in
 	void handleEvent(const SDL_Event& event);	// pass events to their specific handlers
 	void eventWindow(const SDL_WindowEvent& window);
 };
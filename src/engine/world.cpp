@@ -1,15 +1,43 @@
 #include "world.h"
-#include "filer.h"
+#include "batch.h"
 #ifdef _WIN32
 #include <windows.h>
+#include <shellapi.h>
 #endif
 
 WindowSys World::windowSys;
 
+static int launch(int argc, char** argv) {
+	if (Batch::wanted(argc, argv))
+		return Batch::run(argc, argv);
+	return World::winSys()->start(argc > 1 && string(argv[1]) == Default::argLatency);
+}
+
 #if defined(_WIN32) && !defined(_DEBUG)
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine, int nCmdShow) {
+	// pCmdLine lacks the program name, so let windows split the whole command line like it would for main
+	int argc;
+	wchar** wargv = CommandLineToArgvW(GetCommandLineW(), &argc);
+	if (!wargv)
+		return World::winSys()->start();
+
+	vector<string> args(argc);
+	vector<char*> argv(argc + 1, nullptr);
+	for (int i=0; i<argc; i++) {
+		args[i] = wtos(wargv[i]);
+		argv[i] = &args[i][0];
+	}
+	LocalFree(wargv);
+
+	// a windows subsystem program has no console, so batch mode writes to the one it was started from
+	if (Batch::wanted(argc, argv.data()) && AttachConsole(ATTACH_PARENT_PROCESS)) {
+		freopen("CONOUT$", "w", stdout);
+		freopen("CONOUT$", "w", stderr);
+	}
+	return launch(argc, argv.data());
+}
 #else
 int main(int argc, char** argv) {
-#endif
-	return World::winSys()->start();
+	return launch(argc, argv);
 }
+#endif
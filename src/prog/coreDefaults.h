@@ -0,0 +1,154 @@
+#pragma once
+
+// stuff that doesn't depend on SDL, so that the math engine can be used without a window
+#include "utils/vec2.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+
+// to make life easier
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::ostringstream;
+using std::wstring;
+using std::vector;
+using std::map;
+using std::pair;
+using std::make_pair;
+
+template <typename... T>
+using umap = std::unordered_map<T...>;
+template <typename... T>
+using uptr = std::unique_ptr<T...>;
+
+using uchar = unsigned char;
+using ushort = unsigned short;
+using uint = unsigned int;
+using ulong = unsigned long;
+using ullong = unsigned long long;
+using llong = long long;
+using ldouble = long double;
+
+using int8 = int8_t;
+using uint8 = uint8_t;
+using int16 = int16_t;
+using uint16 = uint16_t;
+using int32 = int32_t;
+using uint32 = uint32_t;
+using int64 = int64_t;
+using uint64 = uint64_t;
+using sizt = size_t;
+
+using char16 = char16_t;
+using char32 = char32_t;
+using wchar = wchar_t;
+
+using vec2i = vec2<int>;
+using vec2u = vec2<uint>;
+using vec2f = vec2<float>;
+using vec2d = vec2<double>;
+using vec2t = vec2<sizt>;
+
+// operations of a compiled function (see Bytecode)
+enum class Opcode : uint8 {
+	num,	// load constant
+	arg,	// load argument (x)
+	var,	// load variable
+	add,
+	sub,
+	mul,
+	div,
+	pow,
+	neg,
+	fac,
+	abs,
+	sqrt,
+	cbrt,
+	exp,
+	ln,
+	log,
+	sin,
+	cos,
+	tan,
+	asin,
+	acos,
+	atan,
+	sinh,
+	cosh,
+	tanh,
+	asinh,
+	acosh,
+	atanh,
+	round,
+	ceil,
+	floor,
+	trunc
+};
+
+// directory separator
+#ifdef _WIN32
+const char dsep = '\\';
+#else
+const char dsep = '/';
+#endif
+
+namespace Default {
+
+// parser stuff
+const map<string, double> parserConsts = {
+	pair<string, double>("x", 0.0),
+	pair<string, double>("y", 0.0),
+	pair<string, double>("pi", 3.1415926535897932),
+	pair<string, double>("e", 2.7182818284590452)
+};
+const umap<string, Opcode> parserFuncs = {
+	pair<string, Opcode>("abs", Opcode::abs),
+	pair<string, Opcode>("sqrt", Opcode::sqrt),
+	pair<string, Opcode>("cbrt", Opcode::cbrt),
+	pair<string, Opcode>("exp", Opcode::exp),
+	pair<string, Opcode>("ln", Opcode::ln),
+	pair<string, Opcode>("log", Opcode::log),
+	pair<string, Opcode>("sin", Opcode::sin),
+	pair<string, Opcode>("cos", Opcode::cos),
+	pair<string, Opcode>("tan", Opcode::tan),
+	pair<string, Opcode>("asin", Opcode::asin),
+	pair<string, Opcode>("acos", Opcode::acos),
+	pair<string, Opcode>("atan", Opcode::atan),
+	pair<string, Opcode>("sinh", Opcode::sinh),
+	pair<string, Opcode>("cosh", Opcode::cosh),
+	pair<string, Opcode>("tanh", Opcode::tanh),
+	pair<string, Opcode>("asinh", Opcode::asinh),
+	pair<string, Opcode>("acosh", Opcode::acosh),
+	pair<string, Opcode>("atanh", Opcode::atanh),
+	pair<string, Opcode>("round", Opcode::round),
+	pair<string, Opcode>("ceil", Opcode::ceil),
+	pair<string, Opcode>("floor", Opcode::floor),
+	pair<string, Opcode>("trunc", Opcode::trunc),
+};
+const sizt bytecodeLocalRegs = 64;	// Bytecode programs up to this size don't need any memory allocation to run
+const sizt bytecodeChunk = 256;		// number of x values that Bytecode::solveMany processes at once
+const sizt samplerChunk = 256;		// number of x values per task when sampling in parallel
+const double plotBaseStep = 4.0;	// pixels between the first samples of a graph
+const double plotMaxDensity = 8.0;	// maximum number of samples per pixel when refining a graph
+const double plotTolerance = 0.5;	// how many pixels a graph may stray from a straight line between two samples
+const sizt plotBudget = 65536;		// maximum number of values solved for graphs per frame
+const uint solverIterations = 64;		// limit of Newton/bisection steps when refining a root or extremum
+const double solverPrecision = 1e-12;	// relative distance between steps at which a root or extremum counts as found
+const sizt solverMaxMarkers = 256;		// maximum number of roots and extrema that are searched per graph
+const sizt solverColumns = 128;			// number of columns the view gets split into when looking for graphs that could cross
+const double implicitLeaf = 2.0;	// side length in pixels of the smallest cells that curves get traced through
+const sizt implicitBlock = 8;		// number of smallest cells per side of a block whose corners get solved at once
+const sizt implicitTasks = 8;		// number of quadtree cells per thread that get split off before tracing in parallel
+
+// other random crap
+const sizt arenaBlockSize = 4096;
+
+}
@@ -5,64 +5,7 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 
-#include "utils/vec2.h"
-
-#include <cstdint>
-#include <iostream>
-#include <string>
-#include <sstream>
-#include <vector>
-#include <map>
-#include <unordered_map>
-#include <memory>
-
-// to make life easier
-using std::cout;
-using std::cerr;
-using std::endl;
-using std::string;
-using std::ostringstream;
-using std::wstring;
-using std::vector;
-using std::map;
-using std::pair;
-using std::make_pair;
-
-template <typename... T>
-using umap = std::unordered_map<T...>;
-template <typename... T>
-using uptr = std::unique_ptr<T...>;
-
-using uchar = unsigned char;
-using ushort = unsigned short;
-using uint = unsigned int;
-using ulong = unsigned long;
-using ullong = unsigned long long;
-using llong = long long;
-using ldouble = long double;
-
-using int8 = int8_t;
-using uint8 = uint8_t;
-using int16 = int16_t;
-using uint16 = uint16_t;
-using int32 = int32_t;
-using uint32 = uint32_t;
-using int64 = int64_t;
-using uint64 = uint64_t;
-using sizt = size_t;
-
-using char16 = char16_t;
-using char32 = char32_t;
-using wchar = wchar_t;
-
-using vec2i = vec2<int>;
-using vec2u = vec2<uint>;
-using vec2f = vec2<float>;
-using vec2d = vec2<double>;
-using vec2t = vec2<sizt>;
-
-using mf1ptr = double (*)(double);			// math function (one arg) pointer
-using mf2ptr = double (*)(double, double);	// math function (two args) pointer
+#include "coreDefaults.h"
 
 // get rid of SDL's main
 #ifdef main
@@ -74,13 +17,6 @@ class Program;
 class Widget;
 class Layout;
 
-// directory separator
-#ifdef _WIN32
-const char dsep = '\\';
-#else
-const char dsep = '/';
-#endif
-
 // default constants
 namespace Default {
 
@@ -92,6 +28,7 @@ const vec2f viewportPosition(-1.f, 1.f);
 const vec2f viewportSize(2.f, -2.f);
 const char font[] = "arial";
 const int scrollSpeed = 8;
+const float lineWidth = 1.5f;
 
 // window
 const char windowTitle[] = "BKGraph";
@@ -125,6 +62,7 @@ const SDL_Color colorNoDim = {1, 1, 1, 1};
 const char fileIcon[] = "icon.png";
 const char fileSettings[] = "settings.ini";
 const char fileUsers[] = "users.ini";
+const char fileFonts[] = "fonts.ini";
 
 // INI keywords
 const char iniKeywordFont[] = "font";
@@ -134,39 +72,17 @@ const char iniKeywordFullscreen[] = "fullscreen";
 const char iniKeywordResolution[] = "resolution";
 const char iniKeywordViewport[] = "viewport";
 const char iniKeywordScrollSpeed[] = "scroll_speed";
+const char iniKeywordLineWidth[] = "line_width";
 const char iniKeywordVariable[] = "var";
 const char iniKeywordFunction[] = "func";
+const char iniKeywordDirectory[] = "dir";
 
-// parser stuff
-const map<string, double> parserConsts = {
-	pair<string, double>("x", 0.0),
-	pair<string, double>("pi", 3.1415926535897932),
-	pair<string, double>("e", 2.7182818284590452)
-};
-const umap<string, mf1ptr> parserFuncs = {
-	pair<string, mf1ptr>("abs", std::abs),
-	pair<string, mf1ptr>("sqrt", std::sqrt),
-	pair<string, mf1ptr>("cbrt", std::cbrt),
-	pair<string, mf1ptr>("exp", std::exp),
-	pair<string, mf1ptr>("ln", std::log),
-	pair<string, mf1ptr>("log", std::log10),
-	pair<string, mf1ptr>("sin", std::sin),
-	pair<string, mf1ptr>("cos", std::cos),
-	pair<string, mf1ptr>("tan", std::tan),
-	pair<string, mf1ptr>("asin", std::asin),
-	pair<string, mf1ptr>("acos", std::acos),
-	pair<string, mf1ptr>("atan", std::atan),
-	pair<string, mf1ptr>("sinh", std::sinh),
-	pair<string, mf1ptr>("cosh", std::cosh),
-	pair<string, mf1ptr>("tanh", std::tanh),
-	pair<string, mf1ptr>("asinh", std::asinh),
-	pair<string, mf1ptr>("acosh", std::acosh),
-	pair<string, mf1ptr>("atanh", std::atanh),
-	pair<string, mf1ptr>("round", std::round),
-	pair<string, mf1ptr>("ceil", std::ceil),
-	pair<string, mf1ptr>("floor", std::floor),
-	pair<string, mf1ptr>("trunc", std::trunc),
-};
+// command line arguments
+const char argEval[] = "--eval";
+const char argCsv[] = "--csv";
+const char argBinary[] = "--binary";
+const char argOutput[] = "-o";
+const char argLatency[] = "--latency";	// print input latency when the window gets closed
 
 // widgets' properties
 const int spacing = 10;
@@ -174,6 +90,10 @@ const int itemHeight = 30;
 const int sliderWidth = 10;
 const int caretWidth = 4;
 const int graphClickArea = 4;
+const float graphFeather = 1.f;		// width of the fading edges of graph lines
+const float graphMiterLimit = 2.f;	// how far corners of graph lines can stick out relative to the line's width
+const int markerSize = 7;			// side length of the squares and crosses that mark roots, extrema and crossings
+const sizt getXShown = 4;			// how many x values the "Get X" popup lists
 const float keyMoveFactor = 0.25f;
 const float keyZoomFactor = 2.f;
 const float mouseZoomFactor = 0.05f;
@@ -183,7 +103,11 @@ const float wheelZoomFactor = 0.1f;
 const int fontTestHeight = 100;
 const char fontTestString[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ`~!@#$%^&*()_+-=[]{}'\\\"|;:,.<>/?";
 const int textOffset = 5;
+const sizt textCacheSize = 512;	// maximum number of rendered texts that DrawSys keeps around
+const sizt fontCacheSize = 16;	// maximum number of font sizes that are kept open
 const uint32 eventCheckTimeout = 50;
+const uint32 eventWaitTimeout = 1000;	// longest time the main loop sleeps while waiting for events
 const int scrollFactorWheel = -10;
+const sizt batchBlock = 1 << 18;	// number of values that batch mode solves at once before writing them
 
 }
@@ -113,7 +113,7 @@ void Program::eventVarRename(Button* but) {
 	if (wordValid(ledt->getText())) {
 		vars.insert(make_pair(ledt->getText(), vars[ledt->getOldText()]));
 		vars.erase(ledt->getOldText());
-		parser.updateVars(vars);
+		updateVars();
 	} else
 		World::scene()->setPopup(ProgState::createPopupMessage("Invalid Name", vec2<Size>(300, 100)));
 }
@@ -123,7 +123,7 @@ void Program::eventVarRevalue(Button* but) {
 	double val = stod(static_cast<LineEdit*>(but)->getText());
 
 	vars[key] = val;
-	parser.updateVars(vars);
+	parser.setVar(key, val);
 }
 
 void Program::eventOpenContextVariable(Button* but) {
@@ -148,14 +148,14 @@ void Program::eventAddVariable(Context::Item* item) {
 	}
 
 	vars.insert(make_pair(name, 0.f));
-	parser.updateVars(vars);
+	updateVars();
 	World::scene()->setLayout(state->createLayout());
 }
 
 void Program::eventDelVariable(Context::Item* item) {
 	const string& key = static_cast<LineEdit*>(World::scene()->getContext()->getWidget()->getParent()->getWidget(0))->getText();
 	vars.erase(key);
-	parser.updateVars(vars);
+	updateVars();
 
 	World::scene()->setLayout(state->createLayout());
 }
@@ -165,7 +165,34 @@ void Program::eventGetYConfirm(Button* but) {
 	const string& xstr = static_cast<LineEdit*>(World::scene()->getPopup()->getWidget(1))->getText();
 
 	ostringstream ss;
-	ss << "Y at " << xstr << " is " << funcs[fid].solve(stod(xstr));
+	ss << "Y at " << xstr << " is " << funcs[fid].solve(stod(xstr), parser.getVars());
+	World::scene()->setPopup(ProgState::createPopupMessage(ss.str(), vec2<Size>(400, 100)));
+}
+
+void Program::eventGetXConfirm(Button* but) {
+	const Graph* graph = static_cast<Graph*>(static_cast<GraphView*>(World::scene()->getLayout()->getWidget(1))->data);
+	const string& ystr = static_cast<LineEdit*>(World::scene()->getPopup()->getWidget(1))->getText();
+
+	// look for the level between the graph's dots in the visible x range
+	vector<double> xs(graph->dots.size()), ys(graph->dots.size());
+	for (sizt i=0; i<graph->dots.size(); i++) {
+		xs[i] = graph->dots[i].x;
+		ys[i] = graph->dots[i].y;
+	}
+	double left = World::winSys()->getSettings().viewPos.x;
+	vector<Marker> found;
+	Solver::findLevel(funcs[graph->fid].getCode(), 0, xs, ys, graph->cuts, left, left + World::winSys()->getSettings().viewSize.x, stod(ystr), Marker::Type::level, found, parser.getVars());
+
+	ostringstream ss;
+	if (found.empty())
+		ss << "Y doesn't reach " << ystr << " in view";
+	else {
+		ss << "X at " << ystr << " is ";
+		for (sizt i=0; i<found.size() && i<Default::getXShown; i++)
+			ss << (i ? ", " : "") << found[i].x;
+		if (found.size() > Default::getXShown)
+			ss << " and " << found.size() - Default::getXShown << " more";
+	}
 	World::scene()->setPopup(ProgState::createPopupMessage(ss.str(), vec2<Size>(400, 100)));
 }
 
@@ -202,6 +229,10 @@ void Program::eventSettingScrollSpeed(Button* but) {
 	World::winSys()->setScrollSpeed(stoi(static_cast<LineEdit*>(but)->getText()));
 }
 
+void Program::eventSettingLineWidth(Button* but) {
+	World::winSys()->setLineWidth(stof(static_cast<LineEdit*>(but)->getText()));
+}
+
 void Program::eventSettingReset(Button* but) {
 	World::winSys()->resetSettings();
 	World::scene()->setLayout(state->createLayout());
@@ -212,6 +243,12 @@ void Program::setState(ProgState* newState) {
 	World::scene()->setLayout(state->createLayout());
 }
 
+void Program::updateVars() {
+	parser.updateVars(vars);
+	for (Function& it : funcs)	// variable slots have changed
+		it.setFunc();
+}
+
 bool Program::wordValid(const string& str) {
 	for (char c : str)
 		if (!isLetter(c))
@@ -2,6 +2,7 @@
 
 #include "progs.h"
 #include "utils/parser.h"
+#include "utils/sampler.h"
 
 // handles mostly closely front end related issues
 class Program {
@@ -43,6 +44,7 @@ public:
 
 	// graph view
 	void eventGetYConfirm(Button* but);
+	void eventGetXConfirm(Button* but);
 	
 	// settings view
 	void eventSettingResolution(Button* but);
@@ -52,12 +54,14 @@ public:
 	void eventSettingRendererOpen(Button* but);
 	void eventSettingRendererPick(Context::Item* item);
 	void eventSettingScrollSpeed(Button* but);
+	void eventSettingLineWidth(Button* but);
 	void eventSettingReset(Button* but);
 
 	// other stuff
 	ProgState* getState() { return state.get(); }
 	void setState(ProgState* newState);
 	Parser* getParser() { return &parser; }
+	Sampler* getSampler() { return &sampler; }
 	const Function& getFunction(sizt id) const { return funcs[id]; }
 	const vector<Function>& getFunctions() const { return funcs; }
 	const map<string, double> getVariables() const { return vars; }
@@ -65,8 +69,10 @@ public:
 private:
 	uptr<ProgState> state;
 	Parser parser;
+	Sampler sampler;
 	vector<Function> funcs;
 	map<string, double> vars;
 
+	void updateVars();	// passes vars to parser and recompiles funcs
 	bool wordValid(const string& str);	// checks if str can be used as a variable name
 };
@@ -164,11 +164,13 @@ Layout* ProgSettings::createLayout() {
 	renderer->setWidgets({new Label("Renderer:", nullptr, nullptr, 200), new Label(World::winSys()->getSettings().renderer, &Program::eventSettingRendererOpen, nullptr, 2.f)});
 	Layout* speed = new Layout(30, false);
 	speed->setWidgets({new Label("Scroll Speed:", nullptr, nullptr, 200), new LineEdit(ntos(World::winSys()->getSettings().scrollSpeed), &Program::eventSettingScrollSpeed, nullptr, 1.f, LineEdit::TextType::sIntegerSpaced)});
+	Layout* width = new Layout(30, false);
+	width->setWidgets({new Label("Line Width:", nullptr, nullptr, 200), new LineEdit(ntos(World::winSys()->getSettings().lineWidth), &Program::eventSettingLineWidth, nullptr, 1.f, LineEdit::TextType::uFloating)});
 	Layout* bottom = new Layout(30, false);
 	bottom->setWidgets({new Label("Reset", &Program::eventSettingReset, nullptr, 100)});
 
 	ScrollArea* field = new ScrollArea();
-	field->setWidgets({view, reso, fullscreen, font, renderer, speed, bottom});
+	field->setWidgets({view, reso, fullscreen, font, renderer, speed, width, bottom});
 
 	Layout* lay = new Layout();
 	lay->setWidgets({topbar, field});
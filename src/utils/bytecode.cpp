@@ -0,0 +1,368 @@
+#include "bytecode.h"
+#include <algorithm>
+#include <cstring>
+
+// INSTRUCTION
+
+Instruction::Instruction(Opcode OP, uint A, uint B) :
+	op(OP),
+	a(A),
+	b(B)
+{}
+
+// BYTECODE
+
+Bytecode::Bytecode() :
+	invariant(0)
+{}
+
+void Bytecode::clear() {
+	code.clear();
+	nums.clear();
+	outs.clear();
+	invariant = 0;
+	known.clear();
+	knownNums.clear();
+}
+
+bool Bytecode::usesArg(uint id) const {
+	for (const Instruction& it : code)
+		if (it.op == Opcode::arg && it.a == id)
+			return true;
+	return false;
+}
+
+uint Bytecode::addNum(double num) {
+	uint64 bits;
+	memcpy(&bits, &num, sizeof(bits));
+	umap<uint64, uint>::iterator it = knownNums.find(bits);
+	if (it != knownNums.end())
+		return it->second;
+
+	nums.push_back(num);
+	uint reg = addInstruction(Instruction(Opcode::num, nums.size()-1));
+	knownNums.insert(make_pair(bits, reg));
+	return reg;
+}
+
+uint Bytecode::addArg(uint id) {
+	return addInstruction(Instruction(Opcode::arg, id));
+}
+
+uint Bytecode::addVar(uint slot) {
+	return addInstruction(Instruction(Opcode::var, slot));
+}
+
+uint Bytecode::addOp(Opcode op, uint a, uint b) {
+	if ((op == Opcode::add || op == Opcode::mul) && a > b)	// same order of operands for x+y and y+x
+		std::swap(a, b);
+
+	// solve right away if all operands are constant
+	if (code[a].op == Opcode::num && (!isBinary(op) || code[b].op == Opcode::num))
+		return addNum(solveOp(op, nums[code[a].a], isBinary(op) ? nums[code[b].a] : 0.0));
+
+	// skip operations that don't change the result
+	switch (op) {
+	case Opcode::add:
+		if (isNum(a, 0.0))
+			return b;
+		if (isNum(b, 0.0))
+			return a;
+		break;
+	case Opcode::sub:
+		if (isNum(b, 0.0))
+			return a;
+		if (isNum(a, 0.0))
+			return addOp(Opcode::neg, b);
+		break;
+	case Opcode::mul:
+		if (isNum(a, 1.0))
+			return b;
+		if (isNum(b, 1.0))
+			return a;
+		if (isNum(a, -1.0))
+			return addOp(Opcode::neg, b);
+		if (isNum(b, -1.0))
+			return addOp(Opcode::neg, a);
+		break;
+	case Opcode::div:
+		if (isNum(b, 1.0))
+			return a;
+		break;
+	case Opcode::pow:
+		if (isNum(b, 1.0))
+			return a;
+		if (isNum(b, 0.0))
+			return addNum(1.0);
+		if (isNum(b, 2.0))
+			return addOp(Opcode::mul, a, a);
+		break;
+	case Opcode::neg:
+		if (code[a].op == Opcode::neg)
+			return code[a].a;
+		break;
+	default:
+		break;
+	}
+	return addInstruction(Instruction(op, a, b));
+}
+
+uint Bytecode::append(const Bytecode& src) {
+	vector<uint> ids(src.code.size());
+	for (sizt i=0; i<src.code.size(); i++) {
+		const Instruction& it = src.code[i];
+		if (it.op == Opcode::num)
+			ids[i] = addNum(src.nums[it.a]);
+		else if (it.op == Opcode::arg)
+			ids[i] = addArg(it.a);
+		else if (it.op == Opcode::var)
+			ids[i] = addVar(it.a);
+		else
+			ids[i] = addOp(it.op, ids[it.a], isBinary(it.op) ? ids[it.b] : 0);
+	}
+	return ids[src.outs[0]];
+}
+
+void Bytecode::optimize(const vector<uint>& res) {
+	// find instructions that are needed for res
+	vector<bool> used(code.size(), false);
+	for (uint it : res)
+		used[it] = true;
+	for (sizt i=code.size()-1; i!=SIZE_MAX; i--)
+		if (used[i] && !isLeaf(code[i].op)) {
+			used[code[i].a] = true;
+			if (isBinary(code[i].op))
+				used[code[i].b] = true;
+		}
+
+	// find instructions that depend on x
+	vector<bool> variant(code.size(), false);
+	for (sizt i=0; i<code.size(); i++)
+		variant[i] = (code[i].op == Opcode::arg) || (!isLeaf(code[i].op) && (variant[code[i].a] || (isBinary(code[i].op) && variant[code[i].b])));
+
+	// put used instructions that don't depend on x in front of the ones that do and fix operand registers and constant indices
+	vector<Instruction> ncode;
+	vector<double> nnums;
+	vector<uint> ids(code.size());
+	for (uint8 pass=0; pass<2; pass++) {
+		for (sizt i=0; i<code.size(); i++)
+			if (used[i] && variant[i] == bool(pass)) {
+				Instruction ins = code[i];
+				if (ins.op == Opcode::num) {
+					nnums.push_back(nums[ins.a]);
+					ins.a = nnums.size() - 1;
+				} else if (!isLeaf(ins.op)) {
+					ins.a = ids[ins.a];
+					if (isBinary(ins.op))
+						ins.b = ids[ins.b];
+				}
+				ids[i] = ncode.size();
+				ncode.push_back(ins);
+			}
+		if (pass == 0)
+			invariant = ncode.size();
+	}
+	code.swap(ncode);
+	nums.swap(nnums);
+
+	outs.resize(res.size());
+	for (sizt i=0; i<res.size(); i++)
+		outs[i] = ids[res[i]];
+
+	// registers have changed
+	known.clear();
+	knownNums.clear();
+	for (sizt i=0; i<code.size(); i++) {
+		known.insert(make_pair(code[i], i));
+		if (code[i].op == Opcode::num) {
+			uint64 bits;
+			memcpy(&bits, &nums[code[i].a], sizeof(bits));
+			knownNums.insert(make_pair(bits, i));
+		}
+	}
+}
+
+Bytecode Bytecode::difference(sizt a, sizt b) const {
+	Bytecode diff = *this;
+	uint res[2] = { diff.addOp(Opcode::sub, outs[a], outs[b]), outs[a] };
+	diff.optimize(vector<uint>(res, res + 2));
+	return diff;
+}
+
+uint Bytecode::addInstruction(const Instruction& ins) {
+	umap<Instruction, uint, InstructionHash>::iterator it = known.find(ins);
+	if (it != known.end())
+		return it->second;
+
+	code.push_back(ins);
+	known.insert(make_pair(ins, code.size()-1));
+	return code.size() - 1;
+}
+
+double Bytecode::solve(double x, const vector<double>& vars) const {
+	// registers are on the stack unless there's too many of them
+	double local[Default::bytecodeLocalRegs];
+	vector<double> heap;
+	double* regs = local;
+	if (code.size() > Default::bytecodeLocalRegs) {
+		heap.resize(code.size());
+		regs = heap.data();
+	}
+	solveRange(regs, 0, code.size(), x, vars);
+	return regs[outs[0]];
+}
+
+void Bytecode::solveMany(const double* xs, const double* ys, const vector<double*>& res, sizt n, const vector<double>& vars) const {
+	// each register is a column of bytecodeChunk values
+	vector<double> regs(code.size() * Default::bytecodeChunk);
+
+	// registers that don't depend on x get solved only once
+	vector<double> consts(invariant);
+	solveRange(consts.data(), 0, invariant, 0.0, vars);
+	for (sizt i=0; i<invariant; i++)
+		std::fill(regs.begin() + i * Default::bytecodeChunk, regs.begin() + (i+1) * Default::bytecodeChunk, consts[i]);
+
+	for (sizt start=0; start<n; start+=Default::bytecodeChunk) {
+		sizt len = (n - start < Default::bytecodeChunk) ? n - start : Default::bytecodeChunk;
+		for (sizt i=invariant; i<code.size(); i++) {
+			const Instruction& it = code[i];
+			double* col = &regs[i * Default::bytecodeChunk];
+			if (it.op == Opcode::num)
+				std::fill(col, col + len, nums[it.a]);
+			else if (it.op == Opcode::arg && it.a && !ys)
+				std::fill(col, col + len, 0.0);
+			else if (it.op == Opcode::arg)
+				std::copy((it.a ? ys : xs) + start, (it.a ? ys : xs) + start + len, col);
+			else if (it.op == Opcode::var)
+				std::fill(col, col + len, vars[it.a]);
+			else
+				solveColumn(it.op, &regs[it.a * Default::bytecodeChunk], &regs[it.b * Default::bytecodeChunk], col, len);
+		}
+		for (sizt r=0; r<outs.size(); r++) {
+			const double* out = &regs[outs[r] * Default::bytecodeChunk];
+			std::copy(out, out + len, res[r] + start);
+		}
+	}
+}
+
+Dual Bytecode::solveDual(double x, const vector<double>& vars, sizt res) const {
+	Dual local[Default::bytecodeLocalRegs];
+	vector<Dual> heap;
+	Dual* regs = local;
+	if (code.size() > Default::bytecodeLocalRegs) {
+		heap.resize(code.size());
+		regs = heap.data();
+	}
+
+	solveDualRegs(regs, x, vars);
+	return regs[outs[res]];
+}
+
+void Bytecode::solveDual(double x, vector<Dual>& res, const vector<double>& vars) const {
+	Dual local[Default::bytecodeLocalRegs];
+	vector<Dual> heap;
+	Dual* regs = local;
+	if (code.size() > Default::bytecodeLocalRegs) {
+		heap.resize(code.size());
+		regs = heap.data();
+	}
+
+	solveDualRegs(regs, x, vars);
+	res.resize(outs.size());
+	for (sizt r=0; r<outs.size(); r++)
+		res[r] = regs[outs[r]];
+}
+
+void Bytecode::solveInterval(const Interval& x, const Interval& y, vector<Interval>& res, const vector<double>& vars) const {
+	Interval local[Default::bytecodeLocalRegs];
+	vector<Interval> heap;
+	Interval* regs = local;
+	if (code.size() > Default::bytecodeLocalRegs) {
+		heap.resize(code.size());
+		regs = heap.data();
+	}
+
+	for (sizt i=0; i<code.size(); i++) {
+		const Instruction& it = code[i];
+		if (it.op == Opcode::num)
+			regs[i] = Interval(nums[it.a]);
+		else if (it.op == Opcode::arg)
+			regs[i] = it.a ? y : x;
+		else if (it.op == Opcode::var)
+			regs[i] = Interval(vars[it.a]);
+		else
+			regs[i] = solveOp(it.op, regs[it.a], regs[it.b]);
+	}
+	res.resize(outs.size());
+	for (sizt r=0; r<outs.size(); r++)
+		res[r] = regs[outs[r]];
+}
+
+void Bytecode::solveRange(double* regs, sizt first, sizt last, double x, const vector<double>& vars) const {
+	for (sizt i=first; i<last; i++) {
+		const Instruction& it = code[i];
+		if (it.op == Opcode::num)
+			regs[i] = nums[it.a];
+		else if (it.op == Opcode::arg)
+			regs[i] = it.a ? 0.0 : x;
+		else if (it.op == Opcode::var)
+			regs[i] = vars[it.a];
+		else
+			regs[i] = solveOp(it.op, regs[it.a], regs[it.b]);
+	}
+}
+
+void Bytecode::solveDualRegs(Dual* regs, double x, const vector<double>& vars) const {
+	for (sizt i=0; i<code.size(); i++) {
+		const Instruction& it = code[i];
+		if (it.op == Opcode::num)
+			regs[i] = Dual(nums[it.a]);
+		else if (it.op == Opcode::arg)
+			regs[i] = it.a ? Dual(0.0) : Dual(x, 1.0);
+		else if (it.op == Opcode::var)
+			regs[i] = Dual(vars[it.a]);
+		else
+			regs[i] = solveOp(it.op, regs[it.a], regs[it.b]);
+	}
+}
+
+void Bytecode::solveColumn(Opcode op, const double* a, const double* b, double* res, sizt n) {
+	// simple loops for the most common operations so that they can get vectorized
+	switch (op) {
+	case Opcode::add:
+		for (sizt i=0; i<n; i++)
+			res[i] = a[i] + b[i];
+		break;
+	case Opcode::sub:
+		for (sizt i=0; i<n; i++)
+			res[i] = a[i] - b[i];
+		break;
+	case Opcode::mul:
+		for (sizt i=0; i<n; i++)
+			res[i] = a[i] * b[i];
+		break;
+	case Opcode::div:
+		for (sizt i=0; i<n; i++)
+			res[i] = a[i] / b[i];
+		break;
+	case Opcode::pow:
+		for (sizt i=0; i<n; i++)
+			res[i] = std::pow(a[i], b[i]);
+		break;
+	case Opcode::neg:
+		for (sizt i=0; i<n; i++)
+			res[i] = -a[i];
+		break;
+	case Opcode::abs:
+		for (sizt i=0; i<n; i++)
+			res[i] = std::abs(a[i]);
+		break;
+	case Opcode::sqrt:
+		for (sizt i=0; i<n; i++)
+			res[i] = std::sqrt(a[i]);
+		break;
+	default:
+		for (sizt i=0; i<n; i++)
+			res[i] = solveOp(op, a[i], b[i]);
+	}
+}
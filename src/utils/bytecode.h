@@ -0,0 +1,137 @@
+#pragma once
+
+#include "dual.h"
+#include "interval.h"
+
+// one step of a Bytecode program. it's result is stored in the register with the same index as the instruction
+struct Instruction {
+	Instruction(Opcode OP=Opcode::num, uint A=0, uint B=0);
+
+	bool operator==(const Instruction& ins) const { return op == ins.op && a == ins.a && b == ins.b; }
+
+	Opcode op;
+	uint a, b;	// registers of operands or index of constant/argument/variable
+};
+
+// for using Instruction as a hash map key
+struct InstructionHash {
+	sizt operator()(const Instruction& ins) const { return std::hash<uint64>()((uint64(ins.a) << 32 | ins.b) * 31 + uint64(ins.op)); }
+};
+
+// flat version of function trees that gets solved in one loop instead of walking through the trees (equal parts are only solved once)
+class Bytecode {
+public:
+	Bytecode();
+
+	void clear();
+	bool empty() const { return code.empty(); }
+	sizt size() const { return code.size(); }
+
+	sizt results() const { return outs.size(); }
+	bool usesArg(uint id) const;
+
+	uint addNum(double num);			// these return the register of the added instruction (or of an equal one that already exists)
+	uint addArg(uint id);
+	uint addVar(uint slot);
+	uint addOp(Opcode op, uint a, uint b=0);	// constant operations get solved and trivial ones skipped
+	uint append(const Bytecode& src);	// adds src's instructions and returns the register of it's first result
+	void optimize(const vector<uint>& res);	// sets the results, removes instructions that aren't needed for them and moves those that don't depend on x to the front
+	Bytecode difference(sizt a, sizt b) const;	// program with only the instructions for results a and b, whose results are a minus b and a
+
+	double solve(double x, const vector<double>& vars) const;	// returns first result. vars are the values of Parser's variable slots (y is 0 unless it's given)
+	void solveMany(const double* xs, const double* ys, const vector<double*>& res, sizt n, const vector<double>& vars) const;	// solve all results for n points at once (ys can be null)
+	void solveMany(const double* xs, const vector<double*>& ys, sizt n, const vector<double>& vars) const { solveMany(xs, nullptr, ys, n, vars); }	// solve all results for n values of x at once
+	void solveMany(const double* xs, double* ys, sizt n, const vector<double>& vars) const { solveMany(xs, nullptr, vector<double*>(1, ys), n, vars); }
+	Dual solveDual(double x, const vector<double>& vars, sizt res=0) const;	// returns result res and it's derivatives
+	void solveDual(double x, vector<Dual>& res, const vector<double>& vars) const;	// get all results and their derivatives
+	void solveInterval(const Interval& x, const Interval& y, vector<Interval>& res, const vector<double>& vars) const;	// get bounds of all results for all points in x and y
+	void solveInterval(double lo, double hi, vector<Interval>& res, const vector<double>& vars) const { solveInterval(Interval(lo, hi, true), Interval(0.0), res, vars); }	// get bounds of all results for x in [lo, hi]
+
+private:
+	vector<Instruction> code;
+	vector<double> nums;	// constant pool
+	vector<uint> outs;		// registers of results
+	sizt invariant;			// number of instructions at the beginning that don't depend on x
+	umap<Instruction, uint, InstructionHash> known;	// registers of existing instructions
+	umap<uint64, uint> knownNums;	// registers of existing constants by their bit pattern
+
+	uint addInstruction(const Instruction& ins);
+	bool isNum(uint reg, double val) const { return code[reg].op == Opcode::num && nums[code[reg].a] == val; }
+	void solveRange(double* regs, sizt first, sizt last, double x, const vector<double>& vars) const;
+	void solveDualRegs(Dual* regs, double x, const vector<double>& vars) const;
+	static void solveColumn(Opcode op, const double* a, const double* b, double* res, sizt n);	// apply op to each element of registers a and b
+};
+
+inline bool isLeaf(Opcode op) {
+	return op == Opcode::num || op == Opcode::arg || op == Opcode::var;
+}
+
+inline bool isBinary(Opcode op) {
+	return op >= Opcode::add && op <= Opcode::pow;
+}
+
+// calculate result of an operation (b is ignored if op takes one argument)
+inline double solveOp(Opcode op, double a, double b) {
+	switch (op) {
+	case Opcode::add:
+		return a + b;
+	case Opcode::sub:
+		return a - b;
+	case Opcode::mul:
+		return a * b;
+	case Opcode::div:
+		return a / b;
+	case Opcode::pow:
+		return std::pow(a, b);
+	case Opcode::neg:
+		return -a;
+	case Opcode::fac:
+		return factorial(a);
+	case Opcode::abs:
+		return std::abs(a);
+	case Opcode::sqrt:
+		return std::sqrt(a);
+	case Opcode::cbrt:
+		return std::cbrt(a);
+	case Opcode::exp:
+		return std::exp(a);
+	case Opcode::ln:
+		return std::log(a);
+	case Opcode::log:
+		return std::log10(a);
+	case Opcode::sin:
+		return std::sin(a);
+	case Opcode::cos:
+		return std::cos(a);
+	case Opcode::tan:
+		return std::tan(a);
+	case Opcode::asin:
+		return std::asin(a);
+	case Opcode::acos:
+		return std::acos(a);
+	case Opcode::atan:
+		return std::atan(a);
+	case Opcode::sinh:
+		return std::sinh(a);
+	case Opcode::cosh:
+		return std::cosh(a);
+	case Opcode::tanh:
+		return std::tanh(a);
+	case Opcode::asinh:
+		return std::asinh(a);
+	case Opcode::acosh:
+		return std::acosh(a);
+	case Opcode::atanh:
+		return std::atanh(a);
+	case Opcode::round:
+		return std::round(a);
+	case Opcode::ceil:
+		return std::ceil(a);
+	case Opcode::floor:
+		return std::floor(a);
+	case Opcode::trunc:
+		return std::trunc(a);
+	default:
+		return 0.0;
+	}
+}
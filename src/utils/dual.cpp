@@ -0,0 +1,177 @@
+#include "dual.h"
+
+static const double ln10 = 2.3025850929940457;
+
+// DUAL
+
+Dual::Dual(double VAL, double DR1, double DR2) :
+	val(VAL),
+	d1(DR1),
+	d2(DR2)
+{}
+
+// DUAL OPERATIONS
+
+// apply a function g to a using g's value and derivatives at a.val
+static Dual chain(const Dual& a, double g, double g1, double g2) {
+	return Dual(g, g1 * a.d1, g2 * a.d1 * a.d1 + g1 * a.d2);
+}
+
+static Dual mul(const Dual& a, const Dual& b) {
+	return Dual(a.val * b.val, a.d1 * b.val + a.val * b.d1, a.d2 * b.val + 2.0 * a.d1 * b.d1 + a.val * b.d2);
+}
+
+static Dual div(const Dual& a, const Dual& b) {
+	double q = a.val / b.val;
+	double q1 = (a.d1 - q * b.d1) / b.val;
+	return Dual(q, q1, (a.d2 - 2.0 * q1 * b.d1 - q * b.d2) / b.val);
+}
+
+static Dual pow(const Dual& a, const Dual& b) {
+	double p = std::pow(a.val, b.val);
+	if (b.d1 == 0.0 && b.d2 == 0.0)	// constant exponent, which also works for negative bases
+		return chain(a, p, b.val * std::pow(a.val, b.val - 1.0), b.val * (b.val - 1.0) * std::pow(a.val, b.val - 2.0));
+
+	// a^b = e^h with h = b*ln(a)
+	double ln = std::log(a.val);
+	double r = a.d1 / a.val;
+	double h1 = b.d1 * ln + b.val * r;
+	double h2 = b.d2 * ln + 2.0 * b.d1 * r + b.val * (a.d2 / a.val - r * r);
+	return Dual(p, p * h1, p * (h2 + h1 * h1));
+}
+
+static Dual fac(const Dual& a) {
+	// factorial is n times a number that only changes at whole numbers, so it's linear in between
+	double f = factorial(a.val);
+	return chain(a, f, (a.val == 0.0) ? 1.0 : f / a.val, 0.0);
+}
+
+static Dual sqrt(const Dual& a) {
+	double s = std::sqrt(a.val);
+	return chain(a, s, 0.5 / s, -0.25 / (s * a.val));
+}
+
+static Dual cbrt(const Dual& a) {
+	double c = std::cbrt(a.val);
+	return chain(a, c, 1.0 / (3.0 * c * c), -2.0 / (9.0 * c * c * c * c * c));
+}
+
+static Dual exp(const Dual& a) {
+	double e = std::exp(a.val);
+	return chain(a, e, e, e);
+}
+
+static Dual sin(const Dual& a) {
+	double s = std::sin(a.val);
+	return chain(a, s, std::cos(a.val), -s);
+}
+
+static Dual cos(const Dual& a) {
+	double c = std::cos(a.val);
+	return chain(a, c, -std::sin(a.val), -c);
+}
+
+static Dual tan(const Dual& a) {
+	double t = std::tan(a.val);
+	return chain(a, t, 1.0 + t * t, 2.0 * t * (1.0 + t * t));
+}
+
+static Dual asin(const Dual& a) {
+	double q = 1.0 - a.val * a.val;
+	return chain(a, std::asin(a.val), 1.0 / std::sqrt(q), a.val / (q * std::sqrt(q)));
+}
+
+static Dual acos(const Dual& a) {
+	double q = 1.0 - a.val * a.val;
+	return chain(a, std::acos(a.val), -1.0 / std::sqrt(q), -a.val / (q * std::sqrt(q)));
+}
+
+static Dual atan(const Dual& a) {
+	double q = 1.0 + a.val * a.val;
+	return chain(a, std::atan(a.val), 1.0 / q, -2.0 * a.val / (q * q));
+}
+
+static Dual tanh(const Dual& a) {
+	double t = std::tanh(a.val);
+	return chain(a, t, 1.0 - t * t, -2.0 * t * (1.0 - t * t));
+}
+
+static Dual asinh(const Dual& a) {
+	double q = a.val * a.val + 1.0;
+	return chain(a, std::asinh(a.val), 1.0 / std::sqrt(q), -a.val / (q * std::sqrt(q)));
+}
+
+static Dual acosh(const Dual& a) {
+	double q = a.val * a.val - 1.0;
+	return chain(a, std::acosh(a.val), 1.0 / std::sqrt(q), -a.val / (q * std::sqrt(q)));
+}
+
+static Dual atanh(const Dual& a) {
+	double q = 1.0 - a.val * a.val;
+	return chain(a, std::atanh(a.val), 1.0 / q, 2.0 * a.val / (q * q));
+}
+
+Dual solveOp(Opcode op, const Dual& a, const Dual& b) {
+	switch (op) {
+	case Opcode::add:
+		return Dual(a.val + b.val, a.d1 + b.d1, a.d2 + b.d2);
+	case Opcode::sub:
+		return Dual(a.val - b.val, a.d1 - b.d1, a.d2 - b.d2);
+	case Opcode::mul:
+		return mul(a, b);
+	case Opcode::div:
+		return div(a, b);
+	case Opcode::pow:
+		return pow(a, b);
+	case Opcode::neg:
+		return Dual(-a.val, -a.d1, -a.d2);
+	case Opcode::fac:
+		return fac(a);
+	case Opcode::abs:
+		return chain(a, std::abs(a.val), (a.val > 0.0) ? 1.0 : (a.val < 0.0) ? -1.0 : 0.0, 0.0);
+	case Opcode::sqrt:
+		return sqrt(a);
+	case Opcode::cbrt:
+		return cbrt(a);
+	case Opcode::exp:
+		return exp(a);
+	case Opcode::ln:
+		return chain(a, std::log(a.val), 1.0 / a.val, -1.0 / (a.val * a.val));
+	case Opcode::log:
+		return chain(a, std::log10(a.val), 1.0 / (a.val * ln10), -1.0 / (a.val * a.val * ln10));
+	case Opcode::sin:
+		return sin(a);
+	case Opcode::cos:
+		return cos(a);
+	case Opcode::tan:
+		return tan(a);
+	case Opcode::asin:
+		return asin(a);
+	case Opcode::acos:
+		return acos(a);
+	case Opcode::atan:
+		return atan(a);
+	case Opcode::sinh:
+		return chain(a, std::sinh(a.val), std::cosh(a.val), std::sinh(a.val));
+	case Opcode::cosh:
+		return chain(a, std::cosh(a.val), std::sinh(a.val), std::cosh(a.val));
+	case Opcode::tanh:
+		return tanh(a);
+	case Opcode::asinh:
+		return asinh(a);
+	case Opcode::acosh:
+		return acosh(a);
+	case Opcode::atanh:
+		return atanh(a);
+	case Opcode::round:
+		return Dual(std::round(a.val));
+	case Opcode::ceil:
+		return Dual(std::ceil(a.val));
+	case Opcode::floor:
+		return Dual(std::floor(a.val));
+	case Opcode::trunc:
+		return Dual(std::trunc(a.val));
+	default:
+		return Dual();
+	}
+}
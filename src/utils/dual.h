@@ -0,0 +1,13 @@
+#pragma once
+
+#include "utils/utils.h"
+
+// value of a function at some x together with it's first and second derivative, which get carried through each operation
+struct Dual {
+	Dual(double VAL=0.0, double DR1=0.0, double DR2=0.0);
+
+	double val;
+	double d1, d2;	// first and second derivative
+};
+
+Dual solveOp(Opcode op, const Dual& a, const Dual& b);	// calculate result of an operation and it's derivatives (b is ignored if op takes one argument)
@@ -0,0 +1,72 @@
+#include "parser.h"
+
+// SUBFUNCTIOM
+
+SubfunctionF1::SubfunctionF1(Opcode OP, Subfunction* FNC) :
+	op(OP),
+	func(FNC)
+{}
+
+uint SubfunctionF1::compile(Bytecode& code) const {
+	return code.addOp(op, func->compile(code));
+}
+
+SubfunctionF2::SubfunctionF2(Opcode OP, Subfunction* FCL, Subfunction* FCR) :
+	op(OP),
+	funcL(FCL),
+	funcR(FCR)
+{}
+
+uint SubfunctionF2::compile(Bytecode& code) const {
+	uint l = funcL->compile(code);
+	return code.addOp(op, l, funcR->compile(code));
+}
+
+SubfunctionNum::SubfunctionNum(double NUM) :
+	num(NUM)
+{}
+
+uint SubfunctionNum::compile(Bytecode& code) const {
+	return code.addNum(num);
+}
+
+SubfunctionArg::SubfunctionArg(uint ID) :
+	id(ID)
+{}
+
+uint SubfunctionArg::compile(Bytecode& code) const {
+	return code.addArg(id);
+}
+
+SubfunctionVar::SubfunctionVar(uint SLT) :
+	slot(SLT)
+{}
+
+uint SubfunctionVar::compile(Bytecode& code) const {
+	return code.addVar(slot);
+}
+
+// EXPRESSION
+
+Expression::Expression() :
+	func(nullptr),
+	relation(false)
+{}
+
+bool Expression::set(Parser& parser, const string& text) {
+	nodes.reset();
+	code.clear();
+
+	func = parser.createTree(text, nodes);
+	if (func)
+		code.optimize({func->compile(code)});
+	relation = func && (text.find('=') != string::npos || code.usesArg(1));
+	return func;
+}
+
+void Expression::clear() {
+	func = nullptr;
+	relation = false;
+	nodes.clear();
+	code.clear();
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "bytecode.h"
+
+class Parser;
+
+// element of a function tree, which gets compiled into Bytecode (elements are allocated in the owning Expression's Arena)
+class Subfunction {
+public:
+	virtual ~Subfunction() {}
+
+	virtual uint compile(Bytecode& code) const = 0;	// appends instructions and returns the register of the result
+};
+
+class SubfunctionF1 : public Subfunction {
+public:
+	SubfunctionF1(Opcode a=Opcode::neg, Subfunction* b=nullptr);
+	virtual ~SubfunctionF1() {}
+
+	virtual uint compile(Bytecode& code) const;
+
+private:
+	Opcode op;
+	Subfunction* func;
+};
+
+class SubfunctionF2 : public Subfunction {
+public:
+	SubfunctionF2(Opcode a=Opcode::add, Subfunction* b=nullptr, Subfunction* c=nullptr);
+	virtual ~SubfunctionF2() {}
+
+	virtual uint compile(Bytecode& code) const;
+
+private:
+	Opcode op;
+	Subfunction* funcL;
+	Subfunction* funcR;
+};
+
+class SubfunctionNum : public Subfunction {
+public:
+	SubfunctionNum(double a=0.0);
+	virtual ~SubfunctionNum() {}
+
+	virtual uint compile(Bytecode& code) const;
+
+private:
+	double num;
+};
+
+class SubfunctionArg : public Subfunction {
+public:
+	SubfunctionArg(uint a=0);
+	virtual ~SubfunctionArg() {}
+
+	virtual uint compile(Bytecode& code) const;
+
+private:
+	uint id;	// index of argument (0 is x, 1 is y)
+};
+
+class SubfunctionVar : public Subfunction {
+public:
+	SubfunctionVar(uint a=0);
+	virtual ~SubfunctionVar() {}
+
+	virtual uint compile(Bytecode& code) const;
+
+private:
+	uint slot;	// index of variable in Parser's slots
+};
+
+// a parsed and compiled function of x (or a relation of x and y) that doesn't know anything about how it's displayed
+class Expression {
+public:
+	Expression();
+
+	bool set(Parser& parser, const string& text);	// returns false if text isn't a valid function
+	void clear();
+	bool valid() const { return func; }
+	bool implicit() const { return relation; }
+	double solve(double x, const vector<double>& vars) const { return code.solve(x, vars); }
+	Dual solveDual(double x, const vector<double>& vars) const { return code.solveDual(x, vars); }	// value, slope and curvature in one go
+	void solveMany(const double* xs, double* ys, sizt n, const vector<double>& vars) const { code.solveMany(xs, ys, n, vars); }
+	const Bytecode& getCode() const { return code; }
+
+private:
+	Subfunction* func;		// function tree
+	Arena nodes;			// memory of func's elements
+	Bytecode code;			// compiled func used to calculate y
+	bool relation;			// whether func is a curve where f(x, y) = 0 instead of a graph of y = f(x)
+};
@@ -1,54 +1,14 @@
 #include "engine/world.h"
 
-// SUBFUNCTIOM
-
-SubfunctionF1::SubfunctionF1(mf1ptr MF1, Subfunction* FNC) :
-	mf1(MF1),
-	func(FNC)
-{}
-
-double SubfunctionF1::solve() const {
-	return mf1(func->solve());
-}
-
-SubfunctionF2::SubfunctionF2(mf2ptr MF2, Subfunction* FCL, Subfunction* FCR) :
-	mf2(MF2),
-	funcL(FCL),
-	funcR(FCR)
-{}
-
-double SubfunctionF2::solve() const {
-	return mf2(funcL->solve(), funcR->solve());
-}
-
-SubfunctionNum::SubfunctionNum(double NUM) :
-	num(NUM)
-{}
-
-double SubfunctionNum::solve() const {
-	return num;
-}
-
-SubfunctionVar::SubfunctionVar(const string& VAR) :
-	var(VAR)
-{}
-
-double SubfunctionVar::solve()  const {
-	return World::program()->getParser()->getVar(var);
-}
-
 // FUNCTION
 
 Function::Function(bool SHW, const string& TXT, SDL_Color CLR) :
 	show(SHW),
 	color(CLR),
-	text(TXT),
-	func(nullptr)
+	text(TXT)
 {}
 
-Function::Function(const string& line) :
-	func(nullptr)
-{
+Function::Function(const string& line) {
 	set(line);
 }
 
@@ -85,19 +45,5 @@ void Function::set(const string& line) {
 }
 
 bool Function::setFunc() {
-	if (func)
-		delete func;
-	return func = World::program()->getParser()->createTree(text);
-}
-
-void Function::clear() {
-	if (func) {
-		delete func;
-		func = nullptr;
-	}
-}
-
-double Function::solve(double x) const {
-	World::program()->getParser()->setX(x);
-	return func->solve();
+	return expr.set(*World::program()->getParser(), text);
 }
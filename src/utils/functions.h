@@ -1,54 +1,7 @@
 #pragma once
 
 #include "prog/defaults.h"
-
-// element used to calculate Y for X in Function
-class Subfunction {
-public:
-	virtual double solve() const = 0;
-};
-
-class SubfunctionF1 : public Subfunction {
-public:
-	SubfunctionF1(mf1ptr a=nullptr, Subfunction* b=nullptr);
-
-	virtual double solve() const;
-
-private:
-	mf1ptr mf1;
-	uptr<Subfunction> func;
-};
-
-class SubfunctionF2 : public Subfunction {
-public:
-	SubfunctionF2(mf2ptr a=nullptr, Subfunction* b=nullptr, Subfunction* c=nullptr);
-
-	virtual double solve() const;
-
-private:
-	mf2ptr mf2;
-	uptr<Subfunction> funcL, funcR;
-};
-
-class SubfunctionNum : public Subfunction {
-public:
-	SubfunctionNum(double a=0.0);
-
-	virtual double solve() const;
-
-private:
-	double num;
-};
-
-class SubfunctionVar : public Subfunction {
-public:
-	SubfunctionVar(const string& a="");
-
-	virtual double solve() const;
-
-private:
-	string var;
-};
+#include "expression.h"
 
 // stores funciton data and calculates Y for the corresponding X
 class Function {
@@ -56,15 +9,19 @@ public:
 	Function(bool SHW=true, const string& TXT="", SDL_Color CLR=Default::colorGraph);
 	Function(const string& line);
 
-	bool visible() const { return show && func; }
+	bool visible() const { return show && expr.valid(); }
+	bool implicit() const { return expr.implicit(); }
 	void set(const string& line);
 	bool setFunc();
-	void clear();
-	double solve(double x) const;
+	void clear() { expr.clear(); }
+	double solve(double x, const vector<double>& vars) const { return expr.solve(x, vars); }
+	Dual solveDual(double x, const vector<double>& vars) const { return expr.solveDual(x, vars); }
+	void solveMany(const double* xs, double* ys, sizt n, const vector<double>& vars) const { expr.solveMany(xs, ys, n, vars); }
+	const Bytecode& getCode() const { return expr.getCode(); }
 
 	bool show;
 	SDL_Color color;
 	string text;			// function text used to create func
 private:
-	Subfunction* func;		// function tree used to calculate y
+	Expression expr;
 };
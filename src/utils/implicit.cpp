@@ -0,0 +1,153 @@
+#include "implicit.h"
+
+bool ImplicitPlot::update(Sampler& sampler, double left, double right, double bottom, double top, double xscale, double yscale, const vector<double>& vars, const std::atomic<bool>& cancel) {
+	clear();
+	if (!code.results() || !(right > left) || !(top > bottom) || !std::isfinite(right - left) || !std::isfinite(top - bottom))
+		return true;
+
+	// blocks are aligned to the view's corner and the last ones may stick out a bit
+	this->left = left;
+	this->bottom = bottom;
+	xstep = Default::implicitLeaf / std::abs(xscale);
+	ystep = Default::implicitLeaf / std::abs(yscale);
+	cols = sizt(std::ceil((right - left) / xstep / double(Default::implicitBlock)));
+	rows = sizt(std::ceil((top - bottom) / ystep / double(Default::implicitBlock)));
+
+	// the root of the quadtree is the smallest square with a power of two blocks per side that covers the view
+	Cell root(0, 0, 1);
+	while (root.size < cols || root.size < rows)
+		root.size *= 2;
+	for (sizt r=0; r<code.results(); r++) {
+		root.res.push_back(r);
+		root.cont.push_back(false);
+	}
+
+	// split the tree breadth-first until there's enough cells to keep all threads busy
+	vector<Cell> cells(1, root);
+	while (cells.size() < sampler.getPool().size() * Default::implicitTasks && cells[0].size > 1) {
+		vector<Cell> next;
+		for (const Cell& it : cells)
+			split(it, next, vars);
+		cells.swap(next);
+		if (cells.empty() || cancel)
+			return !cancel;
+	}
+
+	vector<vector<vector<vec2d>>> found(cells.size(), vector<vector<vec2d>>(code.results()));
+	sampler.getPool().run(cells.size(), [&](sizt i) {
+		trace(cells[i], found[i], vars, cancel);
+	});
+	if (cancel) {
+		clear();
+		return false;
+	}
+
+	for (const vector<vector<vec2d>>& it : found)
+		for (sizt r=0; r<it.size(); r++)
+			lines[r].insert(lines[r].end(), it[r].begin(), it[r].end());
+	return true;
+}
+
+void ImplicitPlot::clear() {
+	lines.assign(code.results(), vector<vec2d>());
+}
+
+void ImplicitPlot::split(const Cell& cell, vector<Cell>& out, const vector<double>& vars) const {
+	sizt half = cell.size / 2;
+	vector<Interval> bounds;
+	for (uint8 q=0; q<4; q++) {
+		Cell sub(cell.x + (q & 1) * half, cell.y + (q >> 1) * half, half);
+		if (sub.x >= cols || sub.y >= rows)
+			continue;
+
+		// keep the results whose bounds over the quarter include zero
+		code.solveInterval(Interval(leafX(sub.x * Default::implicitBlock), leafX((sub.x + half) * Default::implicitBlock), true), Interval(leafY(sub.y * Default::implicitBlock), leafY((sub.y + half) * Default::implicitBlock), true), bounds, vars);
+		for (sizt r : cell.res)
+			if (bounds[r].contains(0.0)) {
+				sub.res.push_back(r);
+				sub.cont.push_back(bounds[r].cont);
+			}
+		if (!sub.res.empty())
+			out.push_back(sub);
+	}
+}
+
+void ImplicitPlot::trace(const Cell& cell, vector<vector<vec2d>>& out, const vector<double>& vars, const std::atomic<bool>& cancel) const {
+	if (cancel)
+		return;
+	if (cell.size == 1) {
+		march(cell, out, vars);
+		return;
+	}
+
+	vector<Cell> subs;
+	split(cell, subs, vars);
+	for (const Cell& it : subs)
+		trace(it, out, vars, cancel);
+}
+
+void ImplicitPlot::march(const Cell& cell, vector<vector<vec2d>>& out, const vector<double>& vars) const {
+	// solve all corners of the block's leaves at once
+	sizt n = Default::implicitBlock + 1;
+	sizt lx = cell.x * Default::implicitBlock, ly = cell.y * Default::implicitBlock;
+	vector<double> xs(n * n), ys(n * n);
+	for (sizt j=0; j<n; j++)
+		for (sizt i=0; i<n; i++) {
+			xs[j*n+i] = leafX(lx + i);
+			ys[j*n+i] = leafY(ly + j);
+		}
+	vector<vector<double>> vals(code.results(), vector<double>(n * n));
+	vector<double*> res(vals.size());
+	for (sizt r=0; r<vals.size(); r++)
+		res[r] = vals[r].data();
+	code.solveMany(xs.data(), ys.data(), res, n * n, vars);
+
+	for (sizt k=0; k<cell.res.size(); k++) {
+		const vector<double>& val = vals[cell.res[k]];
+		for (sizt j=0; j+1<n; j++)
+			for (sizt i=0; i+1<n; i++) {
+				// corners go counterclockwise from the bottom left and each bit of sign tells whether a corner is above zero
+				sizt id[4] = {j*n+i, j*n+i+1, (j+1)*n+i+1, (j+1)*n+i};
+				uint8 sign = 0;
+				bool finite = true;
+				for (uint8 c=0; c<4; c++) {
+					finite = finite && std::isfinite(val[id[c]]);
+					if (val[id[c]] > 0.0)
+						sign |= 1 << c;
+				}
+				if (!finite || sign == 0 || sign == 15)
+					continue;
+
+				// a sign change can also come from a jump, so leaves in parts where the function isn't continuous need to be checked on their own
+				if (!cell.cont[k] && !continuous(cell.res[k], xs[id[0]], ys[id[0]], xs[id[2]], ys[id[2]], vars))
+					continue;
+
+				// get the points where edge e (from corner e to the next one) crosses zero
+				vec2d pts[4];
+				for (uint8 e=0; e<4; e++) {
+					uint8 f = (e + 1) % 4;
+					if (bool(sign & (1 << e)) != bool(sign & (1 << f))) {
+						double t = val[id[e]] / (val[id[e]] - val[id[f]]);
+						pts[e] = vec2d(xs[id[e]] + (xs[id[f]] - xs[id[e]]) * t, ys[id[e]] + (ys[id[f]] - ys[id[e]]) * t);
+					}
+				}
+
+				if (sign == 5 || sign == 10) {
+					// saddle: the average of the corners decides whether the curves separate the corners that are above zero or the ones that are below
+					double mid = (val[id[0]] + val[id[1]] + val[id[2]] + val[id[3]]) / 4.0;
+					uint8 e = ((mid > 0.0) == bool(sign & 1)) ? 0 : 3;	// cut off corners 1 and 3 or corners 0 and 2
+					for (uint8 c=0; c<4; c++)
+						out[cell.res[k]].push_back(pts[(e+c)%4]);
+				} else
+					for (uint8 e=0; e<4; e++)
+						if (bool(sign & (1 << e)) != bool(sign & (1 << ((e + 1) % 4))))
+							out[cell.res[k]].push_back(pts[e]);
+			}
+	}
+}
+
+bool ImplicitPlot::continuous(sizt res, double x0, double y0, double x1, double y1, const vector<double>& vars) const {
+	vector<Interval> bounds;
+	code.solveInterval(Interval(x0, x1, true), Interval(y0, y1, true), bounds, vars);
+	return bounds[res].cont;
+}
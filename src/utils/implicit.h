@@ -0,0 +1,37 @@
+#pragma once
+
+#include "sampler.h"
+
+// traces the curves where results of a Bytecode of x and y are zero for drawing
+// the view is split into a quadtree whose cells get dropped as soon as interval bounds show that no result can be zero in them. the blocks that are left get solved on a grid and marching squares turns the grid into line segments
+class ImplicitPlot {
+public:
+	Bytecode& getCode() { return code; }
+	bool update(Sampler& sampler, double left, double right, double bottom, double top, double xscale, double yscale, const vector<double>& vars, const std::atomic<bool>& cancel);	// traces the whole view again (scales are pixels per unit). returns false if it gave up because cancel got set
+	void clear();
+
+	const vector<vec2d>& getLines(sizt res) const { return lines[res]; }	// end points of line segments (two per segment)
+
+private:
+	// square of blocks
+	struct Cell {
+		Cell(sizt X=0, sizt Y=0, sizt SIZ=1) : x(X), y(Y), size(SIZ) {}
+
+		sizt x, y, size;	// position and side length in blocks
+		vector<sizt> res;	// results that might be zero in the cell
+		vector<bool> cont;	// whether those results are continuous over the whole cell
+	};
+
+	Bytecode code;
+	vector<vector<vec2d>> lines;	// line segments of each result
+	double left, bottom;			// position of the first leaf
+	double xstep, ystep;			// size of a leaf (smallest cell)
+	sizt cols, rows;				// number of blocks in view
+
+	void split(const Cell& cell, vector<Cell>& out, const vector<double>& vars) const;	// append the quarters of cell that are in view and might contain a curve
+	void trace(const Cell& cell, vector<vector<vec2d>>& out, const vector<double>& vars, const std::atomic<bool>& cancel) const;
+	void march(const Cell& cell, vector<vector<vec2d>>& out, const vector<double>& vars) const;	// run marching squares over a block
+	bool continuous(sizt res, double x0, double y0, double x1, double y1, const vector<double>& vars) const;	// whether result res doesn't jump or end in the rectangle
+	double leafX(sizt i) const { return left + double(i) * xstep; }
+	double leafY(sizt i) const { return bottom + double(i) * ystep; }
+};
@@ -0,0 +1,244 @@
+#include "bytecode.h"
+#include <algorithm>
+#include <limits>
+
+static const double inf = std::numeric_limits<double>::infinity();
+static const double pi = 3.1415926535897932;
+static const double maxFactorial = 200.0;	// anything above this overflows
+
+// INTERVAL
+
+Interval::Interval() :
+	lo(inf),
+	hi(-inf),
+	cont(false)
+{}
+
+Interval::Interval(double val) :
+	lo(val),
+	hi(val),
+	cont(std::isfinite(val))
+{
+	if (!cont) {	// nothing is known about a constant that overflowed or isn't a number, so it mustn't cull anything
+		lo = -inf;
+		hi = inf;
+	}
+}
+
+Interval::Interval(double LO, double HI, bool CNT) :
+	lo(LO),
+	hi(HI),
+	cont(CNT)
+{}
+
+// INTERVAL OPERATIONS
+
+// pushes the bounds outwards by a bit so that rounding errors can't make them too narrow
+static Interval widen(double lo, double hi, bool cont) {
+	if (std::isnan(lo) || std::isnan(hi))
+		return Interval(-inf, inf, false);
+	if (lo > hi)
+		return Interval();
+	return Interval(std::nextafter(lo, -inf), std::nextafter(hi, inf), cont && std::isfinite(lo) && std::isfinite(hi));
+}
+
+// cuts a down to a function's domain [min, max]. the function isn't continuous over a if anything had to be cut off
+static Interval clip(const Interval& a, double min, double max) {
+	if (a.lo >= min && a.hi <= max)
+		return a;
+	return Interval(std::max(a.lo, min), std::min(a.hi, max), false);
+}
+
+static Interval increasing(double (*func)(double), const Interval& a) {
+	return a.empty() ? Interval() : widen(func(a.lo), func(a.hi), a.cont);
+}
+
+static Interval decreasing(double (*func)(double), const Interval& a) {
+	return a.empty() ? Interval() : widen(func(a.hi), func(a.lo), a.cont);
+}
+
+// for functions that are constant between jumps (like floor)
+static Interval stepped(double (*func)(double), const Interval& a) {
+	double l = func(a.lo), h = func(a.hi);
+	return widen(l, h, a.cont && l == h);
+}
+
+// whether [lo, hi] contains a point ofs + k * period for any integer k
+static bool hitsPeriod(double lo, double hi, double ofs, double period) {
+	return std::ceil((lo - ofs) / period) * period + ofs <= hi;
+}
+
+static Interval mul(const Interval& a, const Interval& b) {
+	double vals[4] = {a.lo * b.lo, a.lo * b.hi, a.hi * b.lo, a.hi * b.hi};
+	double lo = inf, hi = -inf;
+	for (double it : vals) {
+		if (std::isnan(it))	// zero times infinity
+			return Interval(-inf, inf, false);
+		lo = std::min(lo, it);
+		hi = std::max(hi, it);
+	}
+	return widen(lo, hi, a.cont && b.cont);
+}
+
+static Interval div(const Interval& a, const Interval& b) {
+	if (b.contains(0.0))
+		return Interval(-inf, inf, false);
+
+	double vals[4] = {a.lo / b.lo, a.lo / b.hi, a.hi / b.lo, a.hi / b.hi};
+	double lo = inf, hi = -inf;
+	for (double it : vals) {
+		if (std::isnan(it))	// infinity divided by infinity
+			return Interval(-inf, inf, false);
+		lo = std::min(lo, it);
+		hi = std::max(hi, it);
+	}
+	return widen(lo, hi, a.cont && b.cont);
+}
+
+static Interval pow(const Interval& a, const Interval& b) {
+	if (b.lo == b.hi) {
+		double e = b.lo;
+		if (e == std::trunc(e)) {	// whole exponents work with negative bases too
+			if (e == 0.0)
+				return Interval(1.0);
+			if (e < 0.0 && a.contains(0.0))
+				return Interval(-inf, inf, false);
+
+			double l = std::pow(a.lo, e), h = std::pow(a.hi, e);
+			if (e > 0.0 && std::fmod(e, 2.0) == 0.0 && a.contains(0.0))
+				return widen(0.0, std::max(l, h), a.cont);
+			return widen(std::min(l, h), std::max(l, h), a.cont);
+		}
+
+		Interval c = clip(a, 0.0, inf);
+		if (c.empty())
+			return c;
+		double l = std::pow(c.lo, e), h = std::pow(c.hi, e);
+		return widen(std::min(l, h), std::max(l, h), c.cont);
+	}
+	if (a.lo > 0.0)	// a^b = e^(b*ln(a))
+		return solveOp(Opcode::exp, mul(b, solveOp(Opcode::ln, a, a)), a);
+	return Interval(-inf, inf, false);
+}
+
+static Interval fac(const Interval& a) {
+	// factorial is increasing, but it jumps at each whole number from 3 onwards (bounds are capped because the loop in factorial would take forever on huge values)
+	double l = factorial(std::min(a.lo, maxFactorial)), h = factorial(std::min(a.hi, maxFactorial));
+	return widen(l, h, a.cont && (a.hi < 3.0 || std::trunc(a.lo) == std::trunc(a.hi)));
+}
+
+static Interval abs(const Interval& a) {
+	if (a.contains(0.0))
+		return Interval(0.0, std::max(-a.lo, a.hi), a.cont);
+	return (a.lo > 0.0) ? a : Interval(-a.hi, -a.lo, a.cont);
+}
+
+static Interval sin(const Interval& a) {
+	if (a.hi - a.lo >= 2.0 * pi)
+		return Interval(-1.0, 1.0, a.cont);
+
+	double l = std::sin(a.lo), h = std::sin(a.hi);
+	double lo = std::min(l, h), hi = std::max(l, h);
+	if (hitsPeriod(a.lo, a.hi, pi / 2.0, 2.0 * pi))
+		hi = 1.0;
+	if (hitsPeriod(a.lo, a.hi, -pi / 2.0, 2.0 * pi))
+		lo = -1.0;
+	return widen(lo, hi, a.cont);
+}
+
+static Interval cos(const Interval& a) {
+	if (a.hi - a.lo >= 2.0 * pi)
+		return Interval(-1.0, 1.0, a.cont);
+
+	double l = std::cos(a.lo), h = std::cos(a.hi);
+	double lo = std::min(l, h), hi = std::max(l, h);
+	if (hitsPeriod(a.lo, a.hi, 0.0, 2.0 * pi))
+		hi = 1.0;
+	if (hitsPeriod(a.lo, a.hi, pi, 2.0 * pi))
+		lo = -1.0;
+	return widen(lo, hi, a.cont);
+}
+
+static Interval tan(const Interval& a) {
+	if (a.hi - a.lo >= pi || hitsPeriod(a.lo, a.hi, pi / 2.0, pi))
+		return Interval(-inf, inf, false);
+
+	double l = std::tan(a.lo), h = std::tan(a.hi);
+	if (l > h)	// a pole that slipped through because of rounding
+		return Interval(-inf, inf, false);
+	return widen(l, h, a.cont);
+}
+
+static Interval cosh(const Interval& a) {
+	if (a.contains(0.0))
+		return widen(1.0, std::cosh(std::max(-a.lo, a.hi)), a.cont);
+	return (a.lo > 0.0) ? increasing(std::cosh, a) : decreasing(std::cosh, a);
+}
+
+Interval solveOp(Opcode op, const Interval& a, const Interval& b) {
+	if (a.empty() || (isBinary(op) && b.empty()))
+		return Interval();
+
+	switch (op) {
+	case Opcode::add:
+		return widen(a.lo + b.lo, a.hi + b.hi, a.cont && b.cont);
+	case Opcode::sub:
+		return widen(a.lo - b.hi, a.hi - b.lo, a.cont && b.cont);
+	case Opcode::mul:
+		return mul(a, b);
+	case Opcode::div:
+		return div(a, b);
+	case Opcode::pow:
+		return pow(a, b);
+	case Opcode::neg:
+		return Interval(-a.hi, -a.lo, a.cont);
+	case Opcode::fac:
+		return fac(a);
+	case Opcode::abs:
+		return abs(a);
+	case Opcode::sqrt:
+		return increasing(std::sqrt, clip(a, 0.0, inf));
+	case Opcode::cbrt:
+		return increasing(std::cbrt, a);
+	case Opcode::exp:
+		return increasing(std::exp, a);
+	case Opcode::ln:
+		return increasing(std::log, clip(a, 0.0, inf));
+	case Opcode::log:
+		return increasing(std::log10, clip(a, 0.0, inf));
+	case Opcode::sin:
+		return sin(a);
+	case Opcode::cos:
+		return cos(a);
+	case Opcode::tan:
+		return tan(a);
+	case Opcode::asin:
+		return increasing(std::asin, clip(a, -1.0, 1.0));
+	case Opcode::acos:
+		return decreasing(std::acos, clip(a, -1.0, 1.0));
+	case Opcode::atan:
+		return increasing(std::atan, a);
+	case Opcode::sinh:
+		return increasing(std::sinh, a);
+	case Opcode::cosh:
+		return cosh(a);
+	case Opcode::tanh:
+		return increasing(std::tanh, a);
+	case Opcode::asinh:
+		return increasing(std::asinh, a);
+	case Opcode::acosh:
+		return increasing(std::acosh, clip(a, 1.0, inf));
+	case Opcode::atanh:
+		return increasing(std::atanh, clip(a, -1.0, 1.0));
+	case Opcode::round:
+		return stepped(std::round, a);
+	case Opcode::ceil:
+		return stepped(std::ceil, a);
+	case Opcode::floor:
+		return stepped(std::floor, a);
+	case Opcode::trunc:
+		return stepped(std::trunc, a);
+	default:
+		return Interval(-inf, inf, false);
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "utils/utils.h"
+
+// bounds of the values that a function takes over a range of x values (all finite values lie in [lo, hi], which is empty if lo > hi)
+struct Interval {
+	Interval();	// empty
+	Interval(double val);
+	Interval(double LO, double HI, bool CNT);
+
+	bool empty() const { return lo > hi; }
+	bool contains(double val) const { return lo <= val && val <= hi; }
+
+	double lo, hi;
+	bool cont;	// whether the function is defined, finite and continuous over the whole range
+};
+
+Interval solveOp(Opcode op, const Interval& a, const Interval& b);	// bounds of op's results for all values in a and b (b is ignored if op takes one argument)
@@ -1,21 +1,29 @@
 #include "parser.h"
 
 void Parser::updateVars(const map<string, double>& pvars) {
-	vars.clear();
-	vars.insert(Default::parserConsts.begin(), Default::parserConsts.end());
+	map<string, double> vars = Default::parserConsts;
 	vars.insert(pvars.begin(), pvars.end());
+
+	// give each variable an index in vals
+	slots.clear();
+	vals.clear();
+	for (const pair<const string, double>& it : vars) {
+		slots.insert(make_pair(it.first, vals.size()));
+		vals.push_back(it.second);
+	}
 }
 
-Subfunction* Parser::createTree(const string& function) {
+Subfunction* Parser::createTree(const string& function, Arena& nodes) {
 	// set and format function string
 	func = function;
 	for (id=0; id<func.length(); id++)	// remove whitespaces
 		if (func[id] == ' ')
-			func.erase(id--);
+			func.erase(id--, 1);
 
 	// check if syntax is correct
 	id = 0;
 	pcnt = 0;
+	relation = false;
 	try {
 		checkFirst();
 		if (pcnt != 0)
@@ -25,9 +33,15 @@ Subfunction* Parser::createTree(const string& function) {
 		return nullptr;
 	}
 
-	// create subfunction tree
+	// create subfunction tree (a relation's sides get subtracted, so that the curve is where the result is zero)
 	id = 0;
-	return readAddSub();
+	arena = &nodes;
+	Subfunction* res = readAddSub();
+	if (func[id] == '=') {
+		id++;
+		res = arena->make<SubfunctionF2>(Opcode::sub, res, readAddSub());
+	}
+	return res;
 }
 
 // CHECKER
@@ -56,7 +70,7 @@ void Parser::checkNumber() {
 
 void Parser::checkWord() {
 	string word = jumpWord();
-	if (vars.count(word))
+	if (slots.count(word))
 		checkVar();
 	else if (Default::parserFuncs.count(word) && func[id] == '(')
 		checkParOpen();
@@ -68,9 +82,10 @@ void Parser::checkVar() {
 	while (func[id] == '!')
 		id++;
 
-	if (isOperator(func[id]))
+	if (isOperator(func[id]) || (func[id] == '=' && !pcnt && !relation)) {
+		relation = relation || func[id] == '=';
 		checkOperator();
-	else if (func[id] == ')')
+	} else if (func[id] == ')')
 		checkParClose();
 	else if (isNumber(func[id]) || isLetter(func[id]) || func[id] == '(') {
 		func.insert(id, "*");
@@ -112,8 +127,8 @@ void Parser::checkParClose() {
 Subfunction* Parser::readAddSub() {
 	Subfunction* res = readMulDiv();
 	while (func[id] == '+' || func[id] == '-') {
-		mf2ptr mfp = (func[id++] == '+') ? dAdd : dSub;
-		res = new SubfunctionF2(mfp, res, readMulDiv());
+		Opcode op = (func[id++] == '+') ? Opcode::add : Opcode::sub;
+		res = arena->make<SubfunctionF2>(op, res, readMulDiv());
 	}
 	return res;
 }
@@ -121,8 +136,8 @@ Subfunction* Parser::readAddSub() {
 Subfunction* Parser::readMulDiv() {
 	Subfunction* res = readPower();
 	while (func[id] == '*' || func[id] == '/') {
-		mf2ptr mfp = (func[id++] == '*') ? dMul : dDiv;
-		res = new SubfunctionF2(mfp, res, readPower());
+		Opcode op = (func[id++] == '*') ? Opcode::mul : Opcode::div;
+		res = arena->make<SubfunctionF2>(op, res, readPower());
 	}
 	return res;
 }
@@ -131,7 +146,7 @@ Subfunction* Parser::readPower() {
 	Subfunction* res = readFirst();
 	while (func[id] == '^') {
 		id++;
-		res = new SubfunctionF2(std::pow, res, readFirst());
+		res = arena->make<SubfunctionF2>(Opcode::pow, res, readFirst());
 	}
 	return res;
 }
@@ -144,11 +159,13 @@ Subfunction* Parser::readFirst() {
 		ret = readWord();
 	else if (func[id] == '(')
 		ret = readParentheses();
-	else if (func[id] == '-')
-		ret = new SubfunctionF1(dNeg, readFirst());
+	else if (func[id] == '-') {
+		id++;
+		ret = arena->make<SubfunctionF1>(Opcode::neg, readFirst());
+	}
 
 	for (; func[id] == '!'; id++)
-		ret = new SubfunctionF1(dFac, ret);
+		ret = arena->make<SubfunctionF1>(Opcode::fac, ret);
 	return ret;
 }
 
@@ -173,14 +190,20 @@ Subfunction* Parser::readNumber() {
 		}
 		res *= fact;
 	}
-	return new SubfunctionNum(res);
+	return arena->make<SubfunctionNum>(res);
 }
 
 Subfunction* Parser::readWord() {
 	string word = jumpWord();
-	if (vars.count(word))
-		return new SubfunctionVar(word);
-	return new SubfunctionF1(Default::parserFuncs.at(word), readParentheses());
+	if (word == "x")
+		return arena->make<SubfunctionArg>(0);
+	if (word == "y")
+		return arena->make<SubfunctionArg>(1);
+	if (Default::parserConsts.count(word))
+		return arena->make<SubfunctionNum>(Default::parserConsts.at(word));
+	if (slots.count(word))
+		return arena->make<SubfunctionVar>(slots.at(word));
+	return arena->make<SubfunctionF1>(Default::parserFuncs.at(word), readParentheses());
 }
 
 // MISC
@@ -1,23 +1,26 @@
 #pragma once
 
-#include "functions.h"
+#include "expression.h"
 #include "utils/utils.h"
 
 // for checking the syntax of functinos and solving them
 class Parser {
 public:
-	void updateVars(const map<string, double>& pvars);	// sets vars from constants and Program's vars}
-	bool isVar(const string& word) const { return vars.count(word); }
-	double getVar(const string& key) const { return vars.at(key); }
-	void setX(double x) { vars["x"] = x; }
+	void updateVars(const map<string, double>& pvars);	// sets slots from constants and Program's vars (functions need to be recompiled afterwards)
+	bool isVar(const string& word) const { return slots.count(word); }
+	const vector<double>& getVars() const { return vals; }
+	void setVar(const string& key, double val) { vals[slots.at(key)] = val; }
 
-	Subfunction* createTree(const string& function);	// returns the structure necessary for calculating Y
+	Subfunction* createTree(const string& function, Arena& nodes);	// returns the structure necessary for calculating Y. it's elements get allocated in nodes
 
 private:
-	umap<string, double> vars;	// merge of Default::parserConsts and Program::vars
+	umap<string, sizt> slots;	// indices of Default::parserConsts and Program::vars in vals
+	vector<double> vals;		// variable values that compiled functions read from
 	string func;	// pointer to the function
 	sizt id;		// for iterating through func
 	int pcnt;		// for counting opening and closing parentheses
+	bool relation;	// whether an '=' has been found
+	Arena* arena;	// where the tree's elements go
 
 	void checkFirst();
 	void checkNumber();
@@ -0,0 +1,269 @@
+#include "plot.h"
+#include <algorithm>
+
+Plot::Plot() :
+	first(0.0),
+	last(-1.0),
+	lower(0.0),
+	upper(-1.0),
+	ymin(0.0),
+	ymax(0.0),
+	step(0.0),
+	minWidth(0.0),
+	scale(0.0)
+{}
+
+void Plot::setView(double left, double right, double bottom, double top, double xscale, double yscale) {
+	double nstep = Default::plotBaseStep / xscale;
+	if (!std::isfinite(nstep) || nstep <= 0.0 || !(right > left)) {
+		clear();
+		first = 0.0;
+		last = -1.0;
+		return;
+	}
+
+	// samples can only be reused if they'd end up in the same spots on the grid and the curvature check gives the same results
+	yscale = std::abs(yscale);	// y axis might point down
+	if (nstep != step || yscale != scale) {
+		clear();
+		step = nstep;
+		minWidth = 1.0 / (xscale * Default::plotMaxDensity);
+		scale = yscale;
+	}
+
+	// parts that were skipped for being off screen might be in view now
+	if (bottom != ymin || top != ymax) {
+		ymin = bottom;
+		ymax = top;
+		for (sizt i=0; i<culled.size(); i++)
+			if (culled[i]) {
+				culled[i] = false;
+				splits[i] = true;
+			}
+	}
+	first = std::floor(left / step);	// the grid reaches one sample past each end of the range
+	last = std::ceil(right / step);
+
+	if (!xs.empty()) {
+		if (first > upper || last < lower)
+			clear();
+		else {
+			trim(first * step, last * step);
+			lower = std::max(lower, first);
+			upper = std::min(upper, last);
+		}
+	}
+}
+
+bool Plot::finished() const {
+	if (!code.results() || first > last)
+		return true;
+	if (xs.empty() || first < lower || last > upper)
+		return false;
+	for (bool it : splits)
+		if (it)
+			return false;
+	return true;
+}
+
+void Plot::clear() {
+	xs.clear();
+	ys.assign(code.results(), vector<double>());
+	splits.clear();
+	culled.clear();
+	cuts.assign(code.results(), vector<bool>());
+}
+
+bool Plot::update(Sampler& sampler, const vector<double>& vars, sizt budget) {
+	if (!code.results() || first > last)
+		return true;
+
+	// sample the parts of the initial grid that aren't covered yet
+	vector<double> gxs;
+	sizt front = 0;
+	if (xs.empty()) {
+		for (double k=first; k<=last; k++)
+			gxs.push_back(k * step);
+		front = gxs.size();
+	} else {
+		for (double k=first; k<lower; k++)
+			gxs.push_back(k * step);
+		front = gxs.size();
+		for (double k=upper+1.0; k<=last; k++)
+			gxs.push_back(k * step);
+	}
+	if (!gxs.empty()) {
+		vector<vector<double>> gys;
+		solve(sampler, gxs, gys, vars);
+		budget -= std::min(budget, gxs.size() * code.results());
+
+		// new samples go in front of and behind the old ones and every interval that they make needs checking
+		bool fresh = xs.empty();
+		sizt back = gxs.size() - front;
+		xs.insert(xs.begin(), gxs.begin(), gxs.begin() + front);
+		xs.insert(xs.end(), gxs.begin() + front, gxs.end());
+		for (sizt r=0; r<ys.size(); r++) {
+			ys[r].insert(ys[r].begin(), gys[r].begin(), gys[r].begin() + front);
+			ys[r].insert(ys[r].end(), gys[r].begin() + front, gys[r].end());
+		}
+		if (fresh)
+			front--;	// there were no old samples to connect to
+		splits.insert(splits.begin(), front, true);
+		splits.insert(splits.end(), back, true);
+		culled.insert(culled.begin(), front, false);
+		culled.insert(culled.end(), back, false);
+		for (vector<bool>& it : cuts) {
+			it.insert(it.begin(), front, false);
+			it.insert(it.end(), back, false);
+		}
+		lower = first;
+		upper = last;
+	}
+
+	// split intervals until they're flat enough or there's no budget left
+	while (budget) {
+		vector<sizt> ids;
+		for (sizt i=0; i<splits.size() && ids.size() * code.results() < budget; i++)
+			if (splits[i]) {
+				if (offScreen(i, vars)) {
+					splits[i] = false;
+					culled[i] = true;
+				} else
+					ids.push_back(i);
+			}
+		if (ids.empty())
+			break;
+		budget -= std::min(budget, ids.size() * code.results());
+
+		vector<double> mxs(ids.size());
+		for (sizt m=0; m<ids.size(); m++)
+			mxs[m] = (xs[ids[m]] + xs[ids[m]+1]) / 2.0;
+		vector<vector<double>> mys;
+		solve(sampler, mxs, mys, vars);
+
+		// merge middle samples into the others
+		vector<double> nxs;
+		vector<vector<double>> nys(ys.size());
+		vector<bool> nsplits, nculled;
+		vector<vector<bool>> ncuts(cuts.size());
+		nxs.reserve(xs.size() + ids.size());
+		for (vector<double>& it : nys)
+			it.reserve(xs.size() + ids.size());
+		nsplits.reserve(splits.size() + ids.size());
+		nculled.reserve(splits.size() + ids.size());
+		for (vector<bool>& it : ncuts)
+			it.reserve(splits.size() + ids.size());
+		for (sizt i=0, m=0; i<xs.size(); i++) {
+			nxs.push_back(xs[i]);
+			for (sizt r=0; r<ys.size(); r++)
+				nys[r].push_back(ys[r][i]);
+
+			if (m < ids.size() && ids[m] == i) {
+				// halves that are as small as they can get are checked for jumps instead
+				bool fine = (xs[i+1] - xs[i]) / 2.0 < minWidth;
+				bool more = !fine && needsSplit(i, mys, m);
+				nxs.push_back(mxs[m]);
+				for (sizt r=0; r<ys.size(); r++)
+					nys[r].push_back(mys[r][m]);
+				nsplits.push_back(more);
+				nsplits.push_back(more);
+				nculled.push_back(false);
+				nculled.push_back(false);
+				if (fine)
+					addCuts(i, mxs[m], mys, m, ncuts, vars);
+				else
+					for (vector<bool>& it : ncuts) {
+						it.push_back(false);
+						it.push_back(false);
+					}
+				m++;
+			} else if (i < splits.size()) {
+				nsplits.push_back(splits[i]);
+				nculled.push_back(culled[i]);
+				for (sizt r=0; r<cuts.size(); r++)
+					ncuts[r].push_back(cuts[r][i]);
+			}
+		}
+		xs.swap(nxs);
+		ys.swap(nys);
+		splits.swap(nsplits);
+		culled.swap(nculled);
+		cuts.swap(ncuts);
+	}
+	return finished();
+}
+
+void Plot::trim(double lo, double hi) {
+	sizt a = std::lower_bound(xs.begin(), xs.end(), lo) - xs.begin();
+	sizt b = std::upper_bound(xs.begin(), xs.end(), hi) - xs.begin();
+	xs.erase(xs.begin() + b, xs.end());
+	xs.erase(xs.begin(), xs.begin() + a);
+	for (vector<double>& it : ys) {
+		it.erase(it.begin() + b, it.end());
+		it.erase(it.begin(), it.begin() + a);
+	}
+	trimIntervals(splits, a, b);
+	trimIntervals(culled, a, b);
+	for (vector<bool>& it : cuts)
+		trimIntervals(it, a, b);
+}
+
+void Plot::trimIntervals(vector<bool>& vals, sizt a, sizt b) {
+	vals.erase(vals.begin() + (b ? b - 1 : 0), vals.end());
+	vals.erase(vals.begin(), vals.begin() + std::min(a, vals.size()));
+}
+
+void Plot::solve(Sampler& sampler, const vector<double>& pos, vector<vector<double>>& res, const vector<double>& vars) {
+	res.resize(code.results());
+	vector<double*> ptrs(res.size());
+	for (sizt r=0; r<res.size(); r++) {
+		res[r].resize(pos.size());
+		ptrs[r] = res[r].data();
+	}
+	sampler.sample(code, pos.data(), ptrs, pos.size(), vars);
+}
+
+bool Plot::needsSplit(sizt i, const vector<vector<double>>& mids, sizt m) const {
+	for (sizt r=0; r<ys.size(); r++) {
+		double a = ys[r][i], b = ys[r][i+1], c = mids[r][m];
+		bool fa = std::isfinite(a), fb = std::isfinite(b), fc = std::isfinite(c);
+		if (fa != fb || fa != fc)	// graph starts, ends or blows up somewhere in here
+			return true;
+		if (fa && std::abs(c - (a + b) / 2.0) * scale > Default::plotTolerance)	// middle is too far off the line between the ends
+			return true;
+	}
+	return false;
+}
+
+bool Plot::offScreen(sizt i, const vector<double>& vars) const {
+	// the ends have to be on the same side of the view before it's worth getting the bounds
+	for (sizt r=0; r<ys.size(); r++)
+		if (!(ys[r][i] > ymax && ys[r][i+1] > ymax) && !(ys[r][i] < ymin && ys[r][i+1] < ymin))
+			return false;
+
+	vector<Interval> bounds;
+	code.solveInterval(xs[i], xs[i+1], bounds, vars);
+	for (const Interval& it : bounds)
+		if (!(it.lo > ymax) && !(it.hi < ymin))
+			return false;
+	return true;
+}
+
+void Plot::addCuts(sizt i, double mid, const vector<vector<double>>& mids, sizt m, vector<vector<bool>>& res, const vector<double>& vars) const {
+	double ends[3] = {xs[i], mid, xs[i+1]};
+	vector<bool> gaps(ys.size());
+	vector<Interval> bounds;
+	for (uint8 h=0; h<2; h++) {
+		// only jumps between finite samples that could cross the view matter, since lines end at samples that aren't finite anyway
+		bool any = false;
+		for (sizt r=0; r<ys.size(); r++) {
+			double a = h ? mids[r][m] : ys[r][i], b = h ? ys[r][i+1] : mids[r][m];
+			gaps[r] = std::isfinite(a) && std::isfinite(b) && std::abs(b - a) * scale > Default::plotTolerance && !(a > ymax && b > ymax) && !(a < ymin && b < ymin);
+			any = any || gaps[r];
+		}
+		if (any)
+			code.solveInterval(ends[h], ends[h+1], bounds, vars);
+		for (sizt r=0; r<ys.size(); r++)
+			res[r].push_back(gaps[r] && !bounds[r].cont);
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "sampler.h"
+
+// samples the results of a Bytecode over a range of x values for drawing. starts off with a coarse grid and adds samples where the graphs bend
+// samples that are still in range are kept when the range moves, as long as the scale stays the same
+// interval bounds are used to skip refining parts that are off screen and to find jumps, where the lines between samples have to be cut
+class Plot {
+public:
+	Plot();
+
+	Bytecode& getCode() { return code; }
+	void setView(double left, double right, double bottom, double top, double xscale, double yscale);	// scales are pixels per unit. only the parts that come into range need to be sampled after this
+	bool update(Sampler& sampler, const vector<double>& vars, sizt budget);	// solves up to budget values and returns true if there's nothing left to refine
+	bool finished() const;
+	void clear();
+
+	const vector<double>& getXs() const { return xs; }
+	const vector<double>& getYs(sizt res) const { return ys[res]; }
+	const vector<bool>& getCuts(sizt res) const { return cuts[res]; }
+
+private:
+	Bytecode code;
+	vector<double> xs;			// x values of samples in ascending order (they're shared by all results)
+	vector<vector<double>> ys;	// y values of each result at xs
+	vector<bool> splits;		// whether the interval from xs[i] to xs[i+1] still needs a sample in the middle
+	vector<bool> culled;		// whether the interval from xs[i] to xs[i+1] wasn't refined because all graphs are off screen there
+	vector<vector<bool>> cuts;	// whether each result jumps between xs[i] and xs[i+1]
+	double first, last;			// range of the initial grid that needs to be sampled (as multiples of step)
+	double lower, upper;		// range of the initial grid that has been sampled (only valid if xs isn't empty)
+	double ymin, ymax;			// range of y values that are in view
+	double step;				// distance between samples of the initial grid
+	double minWidth;			// intervals don't get split below this width
+	double scale;				// pixels per unit on the y axis
+
+	void trim(double lo, double hi);	// remove samples outside of [lo, hi]
+	static void trimIntervals(vector<bool>& vals, sizt a, sizt b);	// keep values of intervals between samples a and b
+	void solve(Sampler& sampler, const vector<double>& pos, vector<vector<double>>& res, const vector<double>& vars);
+	bool needsSplit(sizt i, const vector<vector<double>>& mids, sizt m) const;	// check interval i against it's middle sample m
+	bool offScreen(sizt i, const vector<double>& vars) const;	// whether all graphs stay above or below the view in interval i
+	void addCuts(sizt i, double mid, const vector<vector<double>>& mids, sizt m, vector<vector<bool>>& res, const vector<double>& vars) const;	// append cuts for both halves of interval i
+};
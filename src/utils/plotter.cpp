@@ -0,0 +1,119 @@
+#include "plotter.h"
+
+Plotter::Plotter(Sampler* SMP, void (*NTF)()) :
+	sampler(SMP),
+	notify(NTF),
+	changed(false),
+	done(true),
+	quit(false),
+	ready(nullptr)
+{}
+
+Plotter::~Plotter() {
+	stop();
+	delete ready.exchange(nullptr);
+}
+
+void Plotter::setCode(Bytecode&& code, Bytecode&& curves) {
+	stop();
+	plot.getCode() = std::move(code);
+	plot.clear();
+	this->curves.getCode() = std::move(curves);
+	this->curves.clear();
+	lines.clear();
+	markers.clear();
+	delete ready.exchange(nullptr);
+	start();
+}
+
+void Plotter::setView(double left, double right, double bottom, double top, double xscale, double yscale, const vector<double>& vars) {
+	{
+		std::lock_guard<std::mutex> lock(mlock);
+		view.left = left;
+		view.right = right;
+		view.bottom = bottom;
+		view.top = top;
+		view.xscale = xscale;
+		view.yscale = yscale;
+		view.vars = vars;
+		changed = true;
+	}
+	wake.notify_one();
+}
+
+void Plotter::start() {
+	quit = false;
+	thread = std::thread(&Plotter::run, this);
+}
+
+void Plotter::stop() {
+	if (!thread.joinable())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(mlock);
+		quit = true;
+	}
+	wake.notify_one();
+	thread.join();
+	changed = true;	// the view has to be picked up again after a restart
+}
+
+void Plotter::run() {
+	View cur;	// the view that's being sampled
+	bool traced = false;	// whether curves are done for cur
+	std::unique_lock<std::mutex> lock(mlock);
+	while (true) {
+		wake.wait(lock, [this]() { return quit || changed || !done; });
+		if (quit)
+			return;
+
+		// always continue with the latest view, which drops the work that's left for the previous one
+		if (changed) {
+			cur = view;
+			plot.setView(cur.left, cur.right, cur.bottom, cur.top, cur.xscale, cur.yscale);
+			traced = false;
+			changed = false;
+		}
+
+		// sample in rounds of at most plotBudget values so that a new view gets picked up quickly
+		lock.unlock();
+		bool fin = plot.update(*sampler, cur.vars, Default::plotBudget);
+		publish(cur, true);
+
+		// curves can't reuse anything from the previous view, so they get traced in one go after the graphs are done (which is dropped if the view changes in the meantime)
+		if (fin && !traced) {
+			traced = curves.update(*sampler, cur.left, cur.right, cur.bottom, cur.top, cur.xscale, cur.yscale, cur.vars, changed);
+			if (traced && curves.getCode().results()) {
+				lines.resize(curves.getCode().results());
+				for (sizt r=0; r<lines.size(); r++)
+					lines[r] = curves.getLines(r);
+				publish(cur, false);
+			}
+		}
+		lock.lock();
+		done = fin && traced;
+	}
+}
+
+void Plotter::publish(const View& cur, bool sampled) {
+	uptr<PlotFrame> frame(new PlotFrame);
+	frame->xs = plot.getXs();
+	frame->ys.resize(plot.getCode().results());
+	frame->cuts.resize(frame->ys.size());
+	for (sizt r=0; r<frame->ys.size(); r++) {
+		frame->ys[r] = plot.getYs(r);
+		frame->cuts[r] = plot.getCuts(r);
+	}
+	frame->curves = lines;
+	frame->curves.resize(curves.getCode().results());
+	if (sampled) {
+		markers = Solver::findAll(sampler->getPool(), plot.getCode(), frame->xs, frame->ys, frame->cuts, cur.left, cur.right, cur.vars);
+
+		// comparing every pair of graphs can take a while, so it's dropped as soon as the view moves, in which case the samples still get shown without crossings
+		Solver::findCrossings(sampler->getPool(), plot.getCode(), frame->xs, frame->ys, frame->cuts, cur.left, cur.right, markers, cur.vars, changed);
+	}
+	frame->markers = markers;
+	delete ready.exchange(frame.release());	// get rid of the previous samples if they haven't been taken
+	if (notify)
+		notify();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "implicit.h"
+#include "plot.h"
+#include "solver.h"
+
+// a finished set of samples handed over by a Plotter
+struct PlotFrame {
+	vector<double> xs;
+	vector<vector<double>> ys;	// y values of each result
+	vector<vector<bool>> cuts;	// whether each result jumps between xs[i] and xs[i+1]
+	vector<vector<Marker>> markers;	// roots, extrema and crossings of each result that lie in the view
+	vector<vector<vec2d>> curves;	// line segments of each implicit result (two end points per segment)
+};
+
+// runs a Plot on a background thread, so that nothing has to wait for the functions to get solved
+class Plotter {
+public:
+	Plotter(Sampler* SMP, void (*NTF)()=nullptr);	// NTF gets called from the thread whenever new samples are ready
+	~Plotter();
+
+	void setCode(Bytecode&& code, Bytecode&& curves);	// waits for the thread to stop, throws away all samples and starts again with the new code of graphs and implicit curves
+	void setView(double left, double right, double bottom, double top, double xscale, double yscale, const vector<double>& vars);	// abandons work for the previous view
+	PlotFrame* take() { return ready.exchange(nullptr); }	// returns the latest finished samples if they haven't been taken yet (caller has to delete them)
+
+private:
+	struct View {
+		View() : left(0.0), right(0.0), bottom(0.0), top(0.0), xscale(0.0), yscale(0.0) {}
+
+		double left, right, bottom, top, xscale, yscale;
+		vector<double> vars;
+	};
+
+	Plot plot;		// only touched by the thread while it's running
+	ImplicitPlot curves;	// same as plot
+	vector<vector<vec2d>> lines;	// the latest finished curves, which frames keep showing until the ones for the current view are traced (same as plot)
+	vector<vector<Marker>> markers;	// of the latest frame's samples (same as plot)
+	Sampler* sampler;
+	void (*notify)();
+	std::thread thread;
+	std::mutex mlock;	// for the following members
+	std::condition_variable wake;
+	View view;			// the latest requested view
+	std::atomic<bool> changed;	// whether view has changed since the thread last picked it up (also stops the search for crossings)
+	bool done;			// whether there's nothing left to sample for the current view
+	bool quit;
+	std::atomic<PlotFrame*> ready;	// samples that are waiting to be taken
+
+	void start();
+	void stop();
+	void run();
+	void publish(const View& cur, bool sampled);	// sampled is whether the samples changed since the last frame (their markers get reused otherwise)
+};
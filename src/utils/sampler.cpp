@@ -0,0 +1,15 @@
+#include "sampler.h"
+
+void Sampler::sample(const Bytecode& code, const double* xs, const vector<double*>& ys, sizt n, const vector<double>& vars) {
+	// split x values into tasks of up to samplerChunk values. all results are solved together so that they can share common parts
+	sizt chunks = (n + Default::samplerChunk - 1) / Default::samplerChunk;
+	pool.run(chunks, [&](sizt id) {
+		sizt start = id * Default::samplerChunk;
+		sizt len = (n - start < Default::samplerChunk) ? n - start : Default::samplerChunk;
+
+		vector<double*> out(ys.size());
+		for (sizt i=0; i<ys.size(); i++)
+			out[i] = ys[i] + start;
+		code.solveMany(xs + start, out, len, vars);
+	});
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "bytecode.h"
+#include "threadPool.h"
+
+// calculates y values of functions for arrays of x values on all cores
+class Sampler {
+public:
+	void sample(const Bytecode& code, const double* xs, const vector<double*>& ys, sizt n, const vector<double>& vars);	// fills ys[i] with n values of code's i-th result
+	ThreadPool& getPool() { return pool; }
+
+private:
+	ThreadPool pool;
+};
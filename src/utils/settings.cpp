@@ -3,13 +3,28 @@
 
 // FONT SET
 
+FontSet::FontSet() :
+	heightScale(1.f),
+	dataSize(0),
+	uses(0)
+{}
+
 bool FontSet::init(const string& FILE) {
 	clear();	// get rid of previously loaded fonts
 
+	// read font file
+	void* mem = SDL_LoadFile(FILE.c_str(), &dataSize);
+	if (!mem) {
+		cerr << "couldn't read font " << FILE << endl << SDL_GetError() << endl;
+		return false;
+	}
+	data.reset(mem, SDL_free);
+
 	// check if font can be loaded
-	TTF_Font* tmp = TTF_OpenFont(FILE.c_str(), Default::fontTestHeight);
+	TTF_Font* tmp = openFont(Default::fontTestHeight);
 	if (!tmp) {
 		cerr << "couldn't open font " << FILE << endl << TTF_GetError() << endl;
+		data.reset();
 		return false;
 	}
 	file = FILE;
@@ -25,23 +40,42 @@ bool FontSet::init(const string& FILE) {
 }
 
 void FontSet::clear() {
-	for (const pair<int, TTF_Font*>& it : fonts)
-		TTF_CloseFont(it.second);
+	for (const pair<const int, Font>& it : fonts)
+		TTF_CloseFont(it.second.font);
 	fonts.clear();
 }
 
+TTF_Font* FontSet::openFont(int size) {
+	return data ? TTF_OpenFontRW(SDL_RWFromConstMem(data.get(), int(dataSize)), 1, size) : nullptr;
+}
+
 TTF_Font* FontSet::addSize(int size) {
-	TTF_Font* font = TTF_OpenFont(file.c_str(), size);
-	if (font)
-		fonts.insert(make_pair(size, font));
-	else
+	TTF_Font* font = openFont(size);
+	if (!font) {
 		cerr << "couldn't load font " << file << endl << TTF_GetError() << endl;
+		return nullptr;
+	}
+
+	// close least recently used size if there's too many
+	if (fonts.size() >= Default::fontCacheSize) {
+		map<int, Font>::iterator old = fonts.begin();
+		for (map<int, Font>::iterator it=fonts.begin(); it!=fonts.end(); it++)
+			if (it->second.lastUse < old->second.lastUse)
+				old = it;
+		TTF_CloseFont(old->second.font);
+		fonts.erase(old);
+	}
+	fonts.insert(make_pair(size, Font({font, ++uses})));
 	return font;
 }
 
 TTF_Font* FontSet::getFont(int height) {
 	height = float(height) * heightScale;
-	return (fonts.count(height) == 0) ? addSize(height) : fonts.at(height);	// load font if it hasn't been loaded yet
+	map<int, Font>::iterator it = fonts.find(height);
+	if (it == fonts.end())	// load font if it hasn't been loaded yet
+		return addSize(height);
+	it->second.lastUse = ++uses;
+	return it->second.font;
 }
 
 int FontSet::length(const string& text, int height) {
@@ -54,14 +88,15 @@ int FontSet::length(const string& text, int height) {
 
 // SETTINGS
 
-Settings::Settings(bool MAX, bool FSC, const vec2i& RES, const vec2f& VPS, const vec2f& VSZ, const string& RND, int SSP) :
+Settings::Settings(bool MAX, bool FSC, const vec2i& RES, const vec2f& VPS, const vec2f& VSZ, const string& RND, int SSP, float LWD) :
 	maximized(MAX),
 	fullscreen(FSC),
 	resolution(RES),
 	viewPos(VPS),
 	viewSize(VSZ),
 	renderer(RND),
-	scrollSpeed(SSP)
+	scrollSpeed(SSP),
+	lineWidth(LWD)
 {}
 
 void Settings::setFont(const string& newFont) {
@@ -2,9 +2,11 @@
 
 #include "prog/defaults.h"
 
-// loads different font sizes from one family
+// loads different font sizes from one family. the font file is only read once and all sizes are opened from memory
 class FontSet {
 public:
+	FontSet();
+
 	bool init(const string& FILE);
 	void clear();
 
@@ -12,17 +14,26 @@ public:
 	int length(const string& text, int height);
 
 private:
+	struct Font {
+		TTF_Font* font;
+		uint64 lastUse;
+	};
+
 	float heightScale;	// for scaling down font size to fit requested height
 	string file;
-	map<int, TTF_Font*> fonts;
+	std::shared_ptr<void> data;	// contents of file
+	sizt dataSize;
+	map<int, Font> fonts;	// by point size (only up to fontCacheSize sizes are kept open)
+	uint64 uses;			// counter for finding the least recently used font
 
+	TTF_Font* openFont(int size);
 	TTF_Font* addSize(int size);
 };
 
 // settings I guess?
 class Settings {
 public:
-	Settings(bool MAX=Default::maximized, bool FSC=Default::fullscreen, const vec2i& RES=Default::resolution, const vec2f& VPS=Default::viewportPosition, const vec2f& VSZ=Default::viewportSize, const string& RND="", int SSP=Default::scrollSpeed);
+	Settings(bool MAX=Default::maximized, bool FSC=Default::fullscreen, const vec2i& RES=Default::resolution, const vec2f& VPS=Default::viewportPosition, const vec2f& VSZ=Default::viewportSize, const string& RND="", int SSP=Default::scrollSpeed, float LWD=Default::lineWidth);
 
 	const string& getFont() const { return font; }
 	FontSet& getFontSet() { return fontSet; }
@@ -39,6 +50,7 @@ public:
 	vec2f viewPos, viewSize;
 	string renderer;
 	int scrollSpeed;
+	float lineWidth;	// of graphs (only if the renderer supports geometry)
 private:
 	string font;	// needs to be set outisde of constructor
 	FontSet fontSet;
@@ -0,0 +1,214 @@
+#include "solver.h"
+#include <algorithm>
+#include <limits>
+
+static const double inf = std::numeric_limits<double>::infinity();
+
+// MARKER
+
+Marker::Marker(double X, double Y, Type TYP) :
+	x(X),
+	y(Y),
+	type(TYP)
+{}
+
+// SOLVER
+
+void Solver::findLevel(const Bytecode& code, sizt res, const vector<double>& xs, const vector<double>& ys, const vector<bool>& cuts, double left, double right, double level, Marker::Type type, vector<Marker>& out, const vector<double>& vars) {
+	for (sizt i=0; i<xs.size() && out.size() < Default::solverMaxMarkers; i++) {
+		// a sample that's right on level is a marker by itself, unless the graph stays on level
+		double a = ys[i] - level;
+		if (a == 0.0 && xs[i] >= left && xs[i] <= right && (i == 0 || ys[i-1] - level != 0.0) && (i+1 == xs.size() || ys[i+1] - level != 0.0))
+			out.push_back(Marker(xs[i], level, type));
+
+		// so the lines that end on such a sample don't get searched
+		if (i+1 == xs.size() || xs[i+1] < left || xs[i] > right || (i < cuts.size() && cuts[i]))
+			continue;
+		double b = ys[i+1] - level;
+		if (!std::isfinite(a) || !std::isfinite(b) || a == 0.0 || b == 0.0 || (a < 0.0) == (b < 0.0))
+			continue;
+
+		double x;
+		if (refine(xs[i], xs[i+1], [&](double px, double& deriv) -> double { Dual val = code.solveDual(px, vars, res); deriv = val.d1; return val.val - level; }, x) && x >= left && x <= right)
+			out.push_back(Marker(x, level, type));
+	}
+}
+
+void Solver::findExtrema(const Bytecode& code, sizt res, const vector<double>& xs, const vector<double>& ys, const vector<bool>& cuts, double left, double right, vector<Marker>& out, const vector<double>& vars) {
+	double minGap = (right - left) * Default::solverPrecision;
+	for (sizt i=1; i+1<xs.size() && out.size() < Default::solverMaxMarkers; i++) {
+		if (xs[i+1] < left || xs[i-1] > right || (i < cuts.size() && (cuts[i-1] || cuts[i])))
+			continue;
+
+		// the lines between samples go up and then down or the other way around, so the slope has to be zero somewhere around the middle sample
+		double s0 = ys[i] - ys[i-1], s1 = ys[i+1] - ys[i];
+		if (!std::isfinite(s0) || !std::isfinite(s1) || !((s0 > 0.0 && s1 < 0.0) || (s0 < 0.0 && s1 > 0.0)))
+			continue;
+
+		double x;
+		if (refine(xs[i-1], xs[i+1], [&](double px, double& deriv) -> double { Dual val = code.solveDual(px, vars, res); deriv = val.d2; return val.d1; }, x) && x >= left && x <= right && (out.empty() || out.back().type != Marker::Type::extremum || std::abs(x - out.back().x) > minGap))
+			out.push_back(Marker(x, code.solveDual(x, vars, res).val, Marker::Type::extremum));
+	}
+}
+
+vector<vector<Marker>> Solver::findAll(ThreadPool& pool, const Bytecode& code, const vector<double>& xs, const vector<vector<double>>& ys, const vector<vector<bool>>& cuts, double left, double right, const vector<double>& vars) {
+	vector<vector<Marker>> markers(ys.size());
+	pool.run(ys.size(), [&](sizt r) {
+		findLevel(code, r, xs, ys[r], cuts[r], left, right, 0.0, Marker::Type::root, markers[r], vars);
+		findExtrema(code, r, xs, ys[r], cuts[r], left, right, markers[r], vars);
+	});
+	return markers;
+}
+
+bool Solver::findCrossings(ThreadPool& pool, const Bytecode& code, const vector<double>& xs, const vector<vector<double>>& ys, const vector<vector<bool>>& cuts, double left, double right, vector<vector<Marker>>& out, const vector<double>& vars, const std::atomic<bool>& cancel) {
+	if (xs.size() < 2 || ys.size() < 2)
+		return true;
+
+	// split the lines between samples into columns of the view, so that only results whose values overlap in a column need to be compared
+	sizt cols = Default::solverColumns, lines = xs.size() - 1;
+	vector<sizt> first(cols + 1);
+	sizt i = 0;
+	while (i < lines && xs[i+1] < left)
+		i++;
+	first[0] = i;
+	for (sizt c=1; c<cols; c++) {
+		double start = left + (right - left) * double(c) / double(cols);
+		while (i < lines && xs[i] < start)
+			i++;
+		first[c] = i;
+	}
+	while (i < lines && xs[i] <= right)
+		i++;
+	first[cols] = i;
+
+	vector<vector<Bracket>> colBrackets(cols);
+	pool.run(cols, [&](sizt c) {
+		if (!cancel)
+			findBrackets(ys, cuts, first[c], first[c+1], colBrackets[c]);
+	});
+	vector<Bracket> brackets;
+	for (const vector<Bracket>& it : colBrackets)
+		brackets.insert(brackets.end(), it.begin(), it.end());
+	if (cancel)
+		return false;
+
+	// each pair of results that cross gets a small program for their difference, so that refining doesn't solve the other results
+	vector<sizt> pairIds(ys.size() * ys.size(), SIZE_MAX);
+	vector<sizt> pairs;
+	for (const Bracket& it : brackets)
+		if (!it.hit && pairIds[it.a * ys.size() + it.b] == SIZE_MAX) {
+			pairIds[it.a * ys.size() + it.b] = pairs.size();
+			pairs.push_back(it.a * ys.size() + it.b);
+		}
+	vector<Bytecode> diffs(pairs.size());
+	pool.run(pairs.size(), [&](sizt p) {
+		if (!cancel)
+			diffs[p] = code.difference(pairs[p] / ys.size(), pairs[p] % ys.size());
+	});
+	if (cancel)
+		return false;
+
+	// refine each bracket as a separate task
+	vector<Marker> found(brackets.size());
+	vector<uint8> valid(brackets.size(), false);
+	pool.run(brackets.size(), [&](sizt k) {
+		if (cancel)
+			return;
+
+		const Bracket& br = brackets[k];
+		if (br.hit) {
+			if (xs[br.i] >= left && xs[br.i] <= right) {
+				found[k] = Marker(xs[br.i], ys[br.a][br.i], Marker::Type::crossing);
+				valid[k] = true;
+			}
+			return;
+		}
+
+		const Bytecode& diff = diffs[pairIds[br.a * ys.size() + br.b]];
+		double x;
+		if (refine(xs[br.i], xs[br.i+1], [&](double px, double& deriv) -> double { Dual val = diff.solveDual(px, vars); deriv = val.d1; return val.val; }, x) && x >= left && x <= right) {
+			found[k] = Marker(x, diff.solveDual(x, vars, 1).val, Marker::Type::crossing);
+			valid[k] = true;
+		}
+	});
+	if (cancel)
+		return false;
+
+	for (sizt k=0; k<brackets.size(); k++)
+		if (valid[k] && out[brackets[k].a].size() < Default::solverMaxMarkers)
+			out[brackets[k].a].push_back(found[k]);
+	return true;
+}
+
+void Solver::findBrackets(const vector<vector<double>>& ys, const vector<vector<bool>>& cuts, sizt first, sizt last, vector<Bracket>& out) {
+	// two results can only cross on a line if their ranges over that line overlap, so results whose ranges in the column don't overlap are skipped
+	vector<Range> ranges;
+	for (sizt r=0; r<ys.size(); r++) {
+		Range rng(inf, -inf, r);
+		for (sizt i=first; i<last; i++)
+			if (std::isfinite(ys[r][i]) && std::isfinite(ys[r][i+1]) && !(i < cuts[r].size() && cuts[r][i])) {
+				rng.lo = std::min(rng.lo, std::min(ys[r][i], ys[r][i+1]));
+				rng.hi = std::max(rng.hi, std::max(ys[r][i], ys[r][i+1]));
+			}
+		if (rng.lo <= rng.hi)
+			ranges.push_back(rng);
+	}
+	std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) -> bool { return a.lo < b.lo; });
+
+	for (sizt j=0; j<ranges.size(); j++)
+		for (sizt k=j+1; k<ranges.size() && ranges[k].lo <= ranges[j].hi; k++) {
+			sizt a = std::min(ranges[j].res, ranges[k].res), b = std::max(ranges[j].res, ranges[k].res);
+			sizt end = (last + 1 == ys[a].size()) ? last + 1 : last;	// the final sample doesn't start a line, so the last column takes it
+			for (sizt i=first; i<end; i++) {
+				// results that meet right on a sample cross there once and the lines that end on it don't get searched
+				double da = ys[a][i] - ys[b][i];
+				if (da == 0.0 && (i == 0 || ys[a][i-1] != ys[b][i-1]) && (i+1 == ys[a].size() || ys[a][i+1] != ys[b][i+1]))
+					out.push_back(Bracket(a, b, i, true));
+				if (i == last || (i < cuts[a].size() && cuts[a][i]) || (i < cuts[b].size() && cuts[b][i]))
+					continue;
+
+				double db = ys[a][i+1] - ys[b][i+1];
+				if (std::isfinite(da) && std::isfinite(db) && da != 0.0 && db != 0.0 && (da < 0.0) != (db < 0.0))
+					out.push_back(Bracket(a, b, i));
+			}
+		}
+}
+
+bool Solver::refine(double a, double b, const std::function<double(double, double&)>& target, double& x) {
+	double d;
+	double ga = target(a, d);
+	double gb = target(b, d);
+	if (ga == 0.0 || gb == 0.0) {
+		x = (ga == 0.0) ? a : b;
+		return true;
+	}
+	if (!std::isfinite(ga) || !std::isfinite(gb) || (ga < 0.0) == (gb < 0.0))
+		return false;
+
+	// the target is negative at lo and positive at hi
+	double lo = (ga < 0.0) ? a : b;
+	double hi = (ga < 0.0) ? b : a;
+	x = a - ga * (b - a) / (gb - ga);	// start where the line between the ends crosses zero
+	for (uint i=0; i<Default::solverIterations; i++) {
+		double g = target(x, d);
+		if (g == 0.0)
+			return true;
+		if (g < 0.0)
+			lo = x;
+		else if (g > 0.0)
+			hi = x;
+		else	// hole in the function
+			return false;
+
+		// take a Newton step unless it leaves the bracket, in which case the bracket gets halved instead
+		double nx = x - g / d;
+		if (!(nx > std::min(lo, hi) && nx < std::max(lo, hi)))
+			nx = (lo + hi) / 2.0;
+		bool done = std::abs(nx - x) <= Default::solverPrecision * std::max(1.0, std::abs(x));
+		x = nx;
+		if (done)
+			break;
+	}
+	// a sign change can also come from a pole or a jump, in which case the target doesn't get any smaller towards it
+	return std::abs(target(x, d)) < std::min(std::abs(ga), std::abs(gb));
+}
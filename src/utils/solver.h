@@ -0,0 +1,49 @@
+#pragma once
+
+#include "threadPool.h"
+#include "bytecode.h"
+
+// point of interest on a graph
+struct Marker {
+	enum class Type : uint8 {
+		root,		// graph crosses zero
+		extremum,	// local minimum or maximum
+		level,		// graph reaches a given y value
+		crossing	// graph crosses another graph
+	};
+
+	Marker(double X=0.0, double Y=0.0, Type TYP=Type::root);
+
+	double x, y;
+	Type type;
+};
+
+// finds roots, extrema and points where functions reach a y value by looking for sign changes between existing samples and refining them with Newton's method
+// samples are given as x values, y values of a result and whether the function jumps between two samples (lines between samples that aren't finite or that are cut aren't searched)
+class Solver {
+public:
+	static void findLevel(const Bytecode& code, sizt res, const vector<double>& xs, const vector<double>& ys, const vector<bool>& cuts, double left, double right, double level, Marker::Type type, vector<Marker>& out, const vector<double>& vars);	// where result res reaches level in [left, right]
+	static void findExtrema(const Bytecode& code, sizt res, const vector<double>& xs, const vector<double>& ys, const vector<bool>& cuts, double left, double right, vector<Marker>& out, const vector<double>& vars);
+	static vector<vector<Marker>> findAll(ThreadPool& pool, const Bytecode& code, const vector<double>& xs, const vector<vector<double>>& ys, const vector<vector<bool>>& cuts, double left, double right, const vector<double>& vars);	// roots and extrema of all results (each result is a task)
+	static bool findCrossings(ThreadPool& pool, const Bytecode& code, const vector<double>& xs, const vector<vector<double>>& ys, const vector<vector<bool>>& cuts, double left, double right, vector<vector<Marker>>& out, const vector<double>& vars, const std::atomic<bool>& cancel);	// adds points where two results cross to the markers of the one with the lower index. returns false and leaves out as it was if it gave up because cancel got set
+
+private:
+	// results a and b cross between xs[i] and xs[i+1] or exactly at xs[i] if hit is set
+	struct Bracket {
+		Bracket(sizt A=0, sizt B=0, sizt I=0, bool HIT=false) : a(A), b(B), i(I), hit(HIT) {}
+
+		sizt a, b, i;
+		bool hit;
+	};
+
+	// bounds of a result's lines within a column of the view
+	struct Range {
+		Range(double LO=0.0, double HI=0.0, sizt RES=0) : lo(LO), hi(HI), res(RES) {}
+
+		double lo, hi;
+		sizt res;
+	};
+
+	static void findBrackets(const vector<vector<double>>& ys, const vector<vector<bool>>& cuts, sizt first, sizt last, vector<Bracket>& out);	// for the lines from first to last
+	static bool refine(double a, double b, const std::function<double(double, double&)>& target, double& x);	// find where target (which also returns it's derivative) is zero between a and b. returns false if there's a jump instead
+};
@@ -0,0 +1,64 @@
+#include "threadPool.h"
+
+ThreadPool::ThreadPool(sizt threads) :
+	task(nullptr),
+	count(0),
+	next(0),
+	busy(0),
+	job(0),
+	quit(false)
+{
+	for (sizt i=1; i<threads; i++)
+		workers.push_back(std::thread(&ThreadPool::work, this));
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mlock);
+		quit = true;
+	}
+	wake.notify_all();
+	for (std::thread& it : workers)
+		it.join();
+}
+
+void ThreadPool::run(sizt cnt, const std::function<void(sizt)>& tsk) {
+	std::lock_guard<std::mutex> jlock(jobLock);
+	{
+		std::lock_guard<std::mutex> lock(mlock);
+		task = &tsk;
+		count = cnt;
+		next = 0;
+		busy = workers.size();
+		job++;
+	}
+	wake.notify_all();
+	runTasks();
+
+	// wait for workers to finish their last tasks
+	std::unique_lock<std::mutex> lock(mlock);
+	done.wait(lock, [this]() { return busy == 0; });
+	task = nullptr;
+}
+
+void ThreadPool::work() {
+	uint64 last = 0;
+	std::unique_lock<std::mutex> lock(mlock);
+	while (true) {
+		wake.wait(lock, [this, last]() { return quit || job != last; });
+		if (job == last)	// only quit once the current job is done, so that run doesn't wait for this worker forever
+			return;
+		last = job;
+
+		lock.unlock();
+		runTasks();
+		lock.lock();
+		if (--busy == 0)
+			done.notify_one();
+	}
+}
+
+void ThreadPool::runTasks() {
+	for (sizt i=next++; i<count; i=next++)	// tasks are picked up one by one so faster threads take over more of them
+		(*task)(i);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "prog/coreDefaults.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// keeps a set of worker threads around for running many small tasks in parallel
+class ThreadPool {
+public:
+	ThreadPool(sizt threads=std::thread::hardware_concurrency());	// the calling thread counts as one of the threads
+	~ThreadPool();
+
+	sizt size() const { return workers.size() + 1; }
+	void run(sizt count, const std::function<void(sizt)>& task);	// calls task with indices from 0 to count-1 and returns when all are done
+
+private:
+	vector<std::thread> workers;
+	std::mutex jobLock;		// only one job can run at a time
+	std::mutex mlock;		// for the following members
+	std::condition_variable wake, done;
+	const std::function<void(sizt)>* task;
+	sizt count;					// number of tasks of current job
+	std::atomic<sizt> next;		// index of next task to be picked up
+	sizt busy;					// number of workers that haven't finished the current job yet
+	uint64 job;					// gets incremented for each new job
+	bool quit;
+
+	void work();
+	void runTasks();
+};
@@ -11,6 +11,12 @@ bool strcmpCI(const string& sa, const string& sb) {
 	return true;
 }
 
+string lowercase(string str) {
+	for (char& c : str)
+		c = tolower(c);
+	return str;
+}
+
 vector<vec2t> getWords(const string& line, char spacer) {
 	sizt i = 0;
 	while (line[i] == spacer)	// skip initial spaces
@@ -106,100 +112,41 @@ wstring stow(const string& str) {
 	return std::wstring_convert<std::codecvt_utf8<wchar>, wchar>().from_bytes(str);
 }
 
-SDL_Rect cropRect(SDL_Rect& rect, const SDL_Rect& frame) {
-	if (rect.w <= 0 || rect.h <= 0 || frame.w <= 0 || frame.h <= 0)	// idfk
-		return {0, 0, 0, 0};
-
-	// ends of each rect and frame
-	vec2i rend = rectEnd(rect);
-	vec2i fend = rectEnd(frame);
-	if (rect.x > fend.x || rect.y > fend.y || rend.x < frame.x || rend.y < frame.y) {	// if rect is out of frame
-		rect = {0, 0, 0, 0};
-		return rect;
-	}
+Arena::Arena() :
+	total(0),
+	capacity(0),
+	used(0)
+{}
 
-	// crop rect if it's boundaries are out of frame
-	SDL_Rect crop = {0, 0, 0, 0};
-	if (rect.x < frame.x) {	// left
-		crop.x = frame.x - rect.x;
-		rect.x = frame.x;
-		rect.w -= crop.x;
-	}
-	if (rend.x > fend.x) {	// right
-		crop.w = rend.x - fend.x;
-		rect.w -= crop.w;
-	}
-	if (rect.y < frame.y) {	// top
-		crop.y = frame.y - rect.y;
-		rect.y = frame.y;
-		rect.h -= crop.y;
-	}
-	if (rend.y > fend.y) {	// bottom
-		crop.h = rend.y - fend.y;
-		rect.h -= crop.h;
-	}
-	// get full width and height of crop
-	crop.w += crop.x;
-	crop.h += crop.y;
-	return crop;
-}
-
-SDL_Rect overlapRect(SDL_Rect rect, const SDL_Rect& frame)  {
-	if (rect.w <= 0 || rect.h <= 0 || frame.w <= 0 || frame.h <= 0)		// idfk
-		return rect;
-
-	// ends of both rects
-	vec2i rend = rectEnd(rect);
-	vec2i fend = rectEnd(frame);
-	if (rect.x > fend.x || rect.y > fend.y || rend.x < frame.x || rend.y < frame.y)	// if they don't overlap
-		return {0, 0, 0, 0};
-
-	// crop rect if it's boundaries are out of frame
-	if (rect.x < frame.x) {	// left
-		rect.w -= frame.x - rect.x;
-		rect.x = frame.x;
+void Arena::reset() {
+	if (blocks.size() > 1) {	// merge blocks into one so that the next batch of objects fits in one piece
+		sizt size = total;
+		clear();
+		addBlock(size);
 	}
-	if (rend.x > fend.x)	// right
-		rect.w -= rend.x - fend.x;
-	if (rect.y < frame.y) {	// top
-		rect.h -= frame.y - rect.y;
-		rect.y = frame.y;
-	}
-	if (rend.y > fend.y)	// bottom
-		rect.h -= rend.y - fend.y;
-	return rect;
+	used = 0;
 }
 
-bool cropLine(vec2i& pos, vec2i& end, const SDL_Rect& rect) {
-	if (rect.w <= 0 || rect.h <= 0)	// not dealing with that shit
-		return false;
+void Arena::clear() {
+	blocks.clear();
+	total = 0;
+	capacity = 0;
+	used = 0;
+}
 
-	vec2f dots[5] = {	// start/end points of rect's lines
-		vec2f(rect.x, rect.y),
-		vec2f(rect.x+rect.w-1, rect.y),
-		vec2f(rect.x+rect.w-1, rect.y+rect.h-1),
-		vec2f(rect.x, rect.y+rect.h-1),
-		vec2f(rect.x, rect.y)
-	};
-	vec2f vec = end - pos;
-	vec2f ins[3];	// points of intersections
-	uint8 hits = 0;	// number of found intersections (there shouldn't be more than 3)
-	for (uint8 i=0; i<4 && hits<3; i++)	// check rect's lines (no need to check for more than 3 hits)
-		hits += intersect(ins[hits], ins[hits+1], vec2f(pos), vec, dots[i], dots[i+1]-dots[i]);
-
-	if (hits == 0)
-		return inRect(pos, rect) && inRect(end, rect);	// if line is inside of rect
-	if (hits == 1 || (hits == 2 && ins[0] == ins[1])) {	// one intersection (line might be crossing corner)
-		if (inRect(pos, rect))	// one point has to be inside so set the other one to the intersection
-			end = ins[0];
-		else
-			pos = ins[0];
-		return true;
-	}
-	if (hits == 2 || hits == 3) {	// two separate intersections or overlapping lines (might be 3 hits if line crosses a corner)
-		pos = ins[0];
-		end = ins[hits-1];
-		return true;
+void* Arena::alloc(sizt size, sizt align) {
+	sizt pos = (used + align - 1) / align * align;
+	if (blocks.empty() || pos + size > capacity) {
+		addBlock((size > Default::arenaBlockSize) ? size : Default::arenaBlockSize);
+		pos = 0;
 	}
-	return false;
+	used = pos + size;
+	return blocks.back().get() + pos;
+}
+
+void Arena::addBlock(sizt size) {
+	blocks.push_back(uptr<uint8[]>(new uint8[size]));
+	total += size;
+	capacity = size;
+	used = 0;
 }
@@ -1,9 +1,10 @@
 #pragma once
 
-#include "prog/defaults.h"
+#include "prog/coreDefaults.h"
 
 // string stuff
 bool strcmpCI(const string& sa, const string& sb);
+string lowercase(string str);
 vector<vec2t> getWords(const string& line, char spacer=' ');	// returns index of first character and length of words in line
 
 // path string functions
@@ -46,25 +47,25 @@ T factorial(T n) {
 	return n;
 }
 
-inline double dAdd(double a, double b) { return a + b; }
-inline double dSub(double a, double b) { return a - b; }
-inline double dMul(double a, double b) { return a * b; }
-inline double dDiv(double a, double b) { return a / b; }
-inline double dNeg(double a) { return -a; }
-inline double dFac(double a) { return factorial(a); }
+// allocates objects one after another in big blocks of memory that get freed all at once (the objects' destructors don't get called)
+class Arena {
+public:
+	Arena();
 
-// geometry?
-SDL_Rect cropRect(SDL_Rect& rect, const SDL_Rect& frame);	// crop rect so it fits in the frame (aka set rect to the area where they overlap) and return how much was cut off
-SDL_Rect overlapRect(SDL_Rect rect, const SDL_Rect& frame);	// same as above except it returns the overlap instead of the crop
-bool cropLine(vec2i& pos, vec2i& end, const SDL_Rect& rect);	// crops line to frame. returns whether line overlaps rect
+	template <typename T, typename... A>
+	T* make(A&&... args) { return new (alloc(sizeof(T), alignof(T))) T(std::forward<A>(args)...); }
+	void reset();	// makes memory availible for reuse
+	void clear();	// frees memory
 
-inline vec2i rectEnd(const SDL_Rect& rect) {
-	return vec2i(rect.x + rect.w - 1, rect.y + rect.h - 1);
-}
+private:
+	vector<uptr<uint8[]>> blocks;
+	sizt total;		// size of all blocks
+	sizt capacity;	// size of last block
+	sizt used;		// bytes used in last block
 
-inline bool inRect(const vec2i& point, const SDL_Rect& rect) {	// check if point is in rect
-	return point.x >= rect.x && point.x < rect.x + rect.w && point.y >= rect.y && point.y < rect.y + rect.h;
-}
+	void* alloc(sizt size, sizt align);
+	void addBlock(sizt size);
+};
 
 template <typename T>	// convert dot from coordinate system to pixels in window
 T dotToPix(const T& dot, const T& start, const T& size, const T& frame) {
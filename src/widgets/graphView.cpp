@@ -2,14 +2,16 @@
 
 // GRAPH ELEMENT
 
-Graph::Graph(sizt FID) :
-	fid(FID)
+Graph::Graph(sizt FID, bool IMP) :
+	fid(FID),
+	implicit(IMP)
 {}
 
 // GRAPH VIEW
 
 GraphView::GraphView(const Size& SIZ, void* DAT) :
-	Widget(SIZ, DAT)
+	Widget(SIZ, DAT),
+	plotter(World::program()->getSampler(), WindowSys::wakeUp)
 {}
 
 void GraphView::drawSelf() {
@@ -45,16 +47,29 @@ bool GraphView::onClick(const vec2i& mPos, uint8 mBut) {
 		data = getMouseOverGraph(mPos);
 		if (data)
 			World::scene()->setPopup(ProgState::createPopupTextInput("Get Y", &Program::eventGetYConfirm, LineEdit::TextType::sFloating, vec2<Size>(300, 200)));
+	} else if (mBut == SDL_BUTTON_MIDDLE) {
+		data = getMouseOverGraph(mPos);
+		if (data)
+			World::scene()->setPopup(ProgState::createPopupTextInput("Get X", &Program::eventGetXConfirm, LineEdit::TextType::sFloating, vec2<Size>(300, 200)));
 	}
 	return true;
 }
 
 Graph* GraphView::getMouseOverGraph(const vec2i& mPos) {
-	vec2i pos = position();
-	sizt i = mPos.x - pos.x;
-	for (Graph& it : graphs)
-		if (inRange(mPos.y, it.pixs[i].y - Default::graphClickArea, it.pixs[i].y + Default::graphClickArea))
+	// dots aren't evenly spaced, so the functions get solved right under the mouse
+	vec2d pos = position();
+	vec2d siz = size();
+	vec2d vpos = World::winSys()->getSettings().viewPos;
+	vec2d vsiz = World::winSys()->getSettings().viewSize;
+	double x = vpos.x + (double(mPos.x) - pos.x) / siz.x * vsiz.x;
+	for (Graph& it : graphs) {
+		if (it.implicit)
+			continue;
+
+		double y = pos.y + dotToPix(World::program()->getFunction(it.fid).solve(x, World::program()->getParser()->getVars()), vpos.y, vsiz.y, siz.y);
+		if (inRange(double(mPos.y), y - Default::graphClickArea, y + Default::graphClickArea))
 			return &it;
+	}
 	return nullptr;
 }
 
@@ -80,31 +95,84 @@ void GraphView::zoom(float mov) {
 }
 
 void GraphView::onResize() {
-	int siz = size().x;
-	for (Graph& it : graphs) {
-		it.dots.resize(siz);	// one dot for each pixel along the x axis
-		it.pixs.resize(siz);
-	}
 	updateDots();
 }
 
+void GraphView::onTick() {
+	// pick up the newest samples if there are any
+	uptr<PlotFrame> frame(plotter.take());
+	if (frame) {
+		// graphs and curves are in the same order as their results
+		for (sizt g=0, r=0, c=0; g<graphs.size(); g++) {
+			if (graphs[g].implicit) {
+				graphs[g].dots.swap(frame->curves[c++]);
+				continue;
+			}
+
+			graphs[g].dots.resize(frame->xs.size());
+			for (sizt i=0; i<frame->xs.size(); i++)
+				graphs[g].dots[i] = vec2d(frame->xs[i], frame->ys[r][i]);
+			graphs[g].cuts.swap(frame->cuts[r]);
+			graphs[g].markers.swap(frame->markers[r]);
+			r++;
+		}
+		updatePixs();
+		World::winSys()->setRedraw();
+	}
+}
+
 void GraphView::setGraphs(const vector<Function>& funcs) {
+	Bytecode code, curves;
+	vector<uint> res, cres;
 	for (sizt i=0; i<funcs.size(); i++)
-		if (funcs[i].visible())
-			graphs.push_back(Graph(i));
+		if (funcs[i].visible()) {
+			graphs.push_back(Graph(i, funcs[i].implicit()));
+			if (funcs[i].implicit())
+				cres.push_back(curves.append(funcs[i].getCode()));
+			else
+				res.push_back(code.append(funcs[i].getCode()));
+		}
+	code.optimize(res);
+	curves.optimize(cres);
+	plotter.setCode(std::move(code), std::move(curves));
 	onResize();
 }
 
 void GraphView::updateDots() {
-	vec2i pos = position();
-	vec2f siz = size();
+	vec2d siz = size();
+	vec2d vpos = World::winSys()->getSettings().viewPos;
+	vec2d vsiz = World::winSys()->getSettings().viewSize;
+	plotter.setView(vpos.x, vpos.x + vsiz.x, std::min(vpos.y, vpos.y + vsiz.y), std::max(vpos.y, vpos.y + vsiz.y), siz.x / vsiz.x, siz.y / vsiz.y, World::program()->getParser()->getVars());
+	updatePixs();	// show the old dots at their new position until the new ones are ready
+}
+
+void GraphView::updatePixs() {
+	vec2d siz = size();
+	vec2d vpos = World::winSys()->getSettings().viewPos;
+	vec2d vsiz = World::winSys()->getSettings().viewSize;
 
-	for (Graph& it : graphs)
+	for (Graph& it : graphs) {
+		it.pixs.resize(it.dots.size());
 		for (sizt i=0; i<it.dots.size(); i++) {
-			it.dots[i].x = World::winSys()->getSettings().viewPos.x + World::winSys()->getSettings().viewSize.x / siz.x * float(i);	// get x value in coordinate system
-			it.dots[i].y = World::program()->getFunction(it.fid).solve(it.dots[i].x);	// get the corresponding y value
-			it.pixs[i] = {pos.x + int(i), pos.y + int(dotToPix(it.dots[i].y, World::winSys()->getSettings().viewPos.y, World::winSys()->getSettings().viewSize.y, siz.y))};	// get pixel position
+			// get pixel position and keep values that can't be shown away from the view, so that they don't overflow
+			vec2d pix = dotToPix(it.dots[i], vpos, vsiz, siz);
+			if (std::isnan(pix.y))
+				pix.y = -siz.y;
+			else
+				bringIn(pix.y, -siz.y, siz.y * 2.0);
+			bringIn(pix.x, -siz.x, siz.x * 2.0);
+			it.pixs[i] = vec2f(pix);
+		}
+
+		// markers always lie in the view's x range, so only their y needs to be kept in
+		it.markerPixs.resize(it.markers.size());
+		for (sizt i=0; i<it.markers.size(); i++) {
+			vec2d pix = dotToPix(vec2d(it.markers[i].x, it.markers[i].y), vpos, vsiz, siz);
+			bringIn(pix.y, -siz.y, siz.y * 2.0);
+			it.markerPixs[i] = {int(std::round(pix.x)), int(std::round(pix.y))};
 		}
+	}
+	World::drawSys()->redrawGraphs();
 }
 
 void GraphView::setViewPos(const vec2f& newPos) {
@@ -2,13 +2,18 @@
 
 #include "widgets.h"
 #include "utils/functions.h"
+#include "utils/plotter.h"
 
 struct Graph {
-	Graph(sizt FID=0);
+	Graph(sizt FID=0, bool IMP=false);
 
 	sizt fid;				// index of function in Program::funcs
-	vector<vec2f> dots;		// positions of dots on graph
-	vector<SDL_Point> pixs;	// pixel values of dots in window
+	bool implicit;			// whether the function is a curve of x and y
+	vector<vec2d> dots;		// positions of dots on graph (their number depends on how much the graph bends) or pairs of end points of a curve's segments
+	vector<vec2f> pixs;		// pixel positions of dots relative to the GraphView (not rounded so that lines can be drawn smoothly)
+	vector<bool> cuts;		// whether the line from dots[i] to dots[i+1] has to be left out because the function jumps there
+	vector<Marker> markers;	// roots, extrema and crossings with other graphs in view
+	vector<SDL_Point> markerPixs;	// pixel positions of markers relative to the GraphView
 };
 
 // the thing that displays all the graphs (shouldn't be put inside a scroll area)
@@ -24,16 +29,19 @@ public:
 	virtual void onUndrag(uint8 mBut);
 	virtual void onScroll(int wMov);
 	virtual void onResize();
+	virtual void onTick();
 
-	const vector<Graph> getGraphs() const { return graphs; }
+	const vector<Graph>& getGraphs() const { return graphs; }
 	void setGraphs(const vector<Function>& funcs);
 
 private:
 	vector<Graph> graphs;
+	Plotter plotter;	// samples all graphs in the background (their functions are compiled together so that they share common parts)
 
 	Graph* getMouseOverGraph(const vec2i& mPos);
 	void zoom(float mov);
-	void updateDots();
+	void updateDots();	// let plotter know about the current view
+	void updatePixs();	// get pixs from dots
 	void setViewPos(const vec2f& newPos);
 	void setViewSize(const vec2f& newSize);
 };
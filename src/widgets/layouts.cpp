@@ -43,6 +43,11 @@ void Layout::onResize() {
 		it->onResize();
 }
 
+void Layout::onTick() {
+	for (Widget* it : widgets)
+		it->onTick();
+}
+
 void Layout::setWidgets(const vector<Widget*>& wgts) {
 	for (Widget* it : widgets)	// get rid of previously existing widgets
 		delete it;
@@ -10,6 +10,7 @@ public:
 
 	virtual void drawSelf();
 	virtual void onResize();
+	virtual void onTick();
 
 	Widget* getWidget(sizt id) { return widgets[id]; }
 	const vector<Widget*>& getWidgets() const { return widgets; }
@@ -3,6 +3,19 @@
 #include "prog/defaults.h"
 #include "utils/utils.h"
 
+// geometry?
+SDL_Rect cropRect(SDL_Rect& rect, const SDL_Rect& frame);	// crop rect so it fits in the frame (aka set rect to the area where they overlap) and return how much was cut off
+SDL_Rect overlapRect(SDL_Rect rect, const SDL_Rect& frame);	// same as above except it returns the overlap instead of the crop
+bool cropLine(vec2i& pos, vec2i& end, const SDL_Rect& rect);	// crops line to frame. returns whether line overlaps rect
+
+inline vec2i rectEnd(const SDL_Rect& rect) {
+	return vec2i(rect.x + rect.w - 1, rect.y + rect.h - 1);
+}
+
+inline bool inRect(const vec2i& point, const SDL_Rect& rect) {	// check if point is in rect
+	return point.x >= rect.x && point.x < rect.x + rect.w && point.y >= rect.y && point.y < rect.y + rect.h;
+}
+
 class Size {
 public:
 	Size(int PIX);
@@ -36,6 +49,7 @@ public:
 	virtual void onUndrag(uint8 mBut) {}	// get's called on mouse button up if instance is Scene's capture
 	virtual void onScroll(int wMov) {}	// on mouse wheel y movement
 	virtual void onResize() {}	// for updating values when window size changed
+	virtual void onTick() {}	// gets called once per frame before drawing
 
 	Layout* getParent() const { return parent; }
 	sizt getID() const { return id; }